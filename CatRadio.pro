@@ -1,6 +1,7 @@
 QT       += core gui
 QT       += serialport
 QT       += multimedia
+QT       += network
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++11
@@ -10,53 +11,94 @@ CONFIG += c++11
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    ampdaemon.cpp \
+    compass.cpp \
     debuglogger.cpp \
+    dialogamplifier.cpp \
     dialogcommand.cpp \
     dialogconfig.cpp \
     dialogcwkeyer.cpp \
+    dialogmemory.cpp \
     dialognetrigctl.cpp \
     dialogradioinfo.cpp \
+    dialogrotator.cpp \
     dialogsetup.cpp \
+    dialogstats.cpp \
+    dialogsurvey.cpp \
     dialogvoicekeyer.cpp \
+    doppler.cpp \
+    flightrecorder.cpp \
     guidata.cpp \
+    heatmap.cpp \
+    lagmonitor.cpp \
     main.cpp \
     mainwindow.cpp \
     netrigctl.cpp \
     rigcommand.cpp \
     rigdaemon.cpp \
     rigdata.cpp \
+    rigfollow.cpp \
+    rigmetrics.cpp \
+    rigstats.cpp \
+    rigtape.cpp \
+    rigtrace.cpp \
+    rotdaemon.cpp \
     smeter.cpp \
     submeter.cpp \
+    survey.cpp \
     vfodisplay.cpp \
     winkeyer.cpp
 
 HEADERS += \
+    ampdaemon.h \
+    compass.h \
     debuglogger.h \
+    dialogamplifier.h \
     dialogcommand.h \
     dialogconfig.h \
     dialogcwkeyer.h \
+    dialogmemory.h \
     dialognetrigctl.h \
     dialogradioinfo.h \
+    dialogrotator.h \
     dialogsetup.h \
+    dialogstats.h \
+    dialogsurvey.h \
     dialogvoicekeyer.h \
+    doppler.h \
+    flightrecorder.h \
     guidata.h \
+    heatmap.h \
+    lagmonitor.h \
     mainwindow.h \
     netrigctl.h \
     rigcommand.h \
     rigdaemon.h \
     rigdata.h \
+    rigfollow.h \
+    rigmetrics.h \
+    rigstats.h \
+    rigtape.h \
+    rigtrace.h \
+    rotdaemon.h \
     smeter.h \
     submeter.h \
+    survey.h \
     vfodisplay.h \
     winkeyer.h
 
 FORMS += \
+    dialogamplifier.ui \
     dialogcommand.ui \
     dialogconfig.ui \
     dialogcwkeyer.ui \
+    dialogmemory.ui \
     dialognetrigctl.ui \
     dialogradioinfo.ui \
+    dialogrotator.ui \
     dialogsetup.ui \
+    dialogstats.ui \
+    dialogsurvey.ui \
     dialogvoicekeyer.ui \
     mainwindow.ui
 
@@ -0,0 +1,163 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ampdaemon.h"
+
+#include <QDebug>
+
+
+AmpDaemon::AmpDaemon(QObject *parent) : QObject(parent)
+{
+    pollFast = 100;
+    pollSlow = 1000;
+    indexCmd = 0;
+    pwrFwd = pwrReflected = 0;
+    swr = 1.0;
+}
+
+AmpDaemon::~AmpDaemon()
+{
+    ampDisconnect();
+}
+
+void AmpDaemon::setTx(bool tx)
+{
+    if (txFlag.fetchAndStoreRelaxed(tx) == int(tx)) return;
+
+    if (tx) QMetaObject::invokeMethod(this, [this](){ if (pollTimer && my_amp) pollTimer->start(0); }, Qt::QueuedConnection);  //Check the amplifier as soon as TX starts
+}
+
+//* Open the amplifier, runs on the amplifier thread
+void AmpDaemon::ampConnect(unsigned ampModel, QString ampPort, unsigned serialSpeed, int pollFast, int pollSlow)
+{
+    ampDisconnect();
+
+    this->pollFast = pollFast;
+    this->pollSlow = pollSlow;
+
+    my_amp = amp_init(ampModel);
+    if (!my_amp)    //Wrong amplifier number
+    {
+        emit connected(-RIG_EINVAL, "");
+        return;
+    }
+
+    strncpy(my_amp->state.ampport.pathname, ampPort.toLatin1(), HAMLIB_FILPATHLEN - 1);
+    if (serialSpeed) my_amp->state.ampport.parm.serial.rate = serialSpeed;
+
+    int retcode = amp_open(my_amp);
+    if (retcode != RIG_OK)
+    {
+        amp_cleanup(my_amp);
+        my_amp = nullptr;
+        emit connected(retcode, "");
+        return;
+    }
+
+    qInfo() << "Amplifier connected" << my_amp->caps->model_name;
+    emit connected(RIG_OK, my_amp->caps->model_name);
+
+    indexCmd = 0;
+    lastFault.clear();
+
+    if (!pollTimer)
+    {
+        pollTimer = new QTimer(this);
+        pollTimer->setSingleShot(true);
+        connect(pollTimer, &QTimer::timeout, this, &AmpDaemon::ampUpdate);
+    }
+    ampUpdate();
+}
+
+void AmpDaemon::ampDisconnect()
+{
+    if (pollTimer) pollTimer->stop();
+
+    if (my_amp)
+    {
+        amp_close(my_amp);
+        amp_cleanup(my_amp);
+        my_amp = nullptr;
+        qInfo() << "Amplifier disconnected";
+    }
+
+    if (!lastFault.isEmpty())   //Release the TX interlock
+    {
+        lastFault.clear();
+        emit faultChanged(lastFault);
+    }
+}
+
+void AmpDaemon::resetFault()
+{
+    if (!my_amp) return;
+
+    int retcode = amp_reset(my_amp, AMP_RESET_FAULT);
+    if (retcode != RIG_OK) qWarning() << "Amplifier reset" << rigerror(retcode);
+}
+
+//* Fault strings reported by the backends when everything is fine
+bool AmpDaemon::isFault(QString fault)
+{
+    fault = fault.trimmed();
+    return !(fault.isEmpty() || fault == "0" || fault.compare("None", Qt::CaseInsensitive) == 0 || fault.compare("No fault", Qt::CaseInsensitive) == 0 || fault.compare("OK", Qt::CaseInsensitive) == 0);
+}
+
+//* Poll the amplifier, fault every cycle and the telemetry round robin
+//* While transmitting the whole set is read at the fast rate
+void AmpDaemon::ampUpdate()
+{
+    if (!my_amp) return;
+
+    bool tx = txFlag.loadAcquire();
+    value_t retvalue;
+
+    //* Fault, used by the TX interlock
+    if (amp_get_level(my_amp, AMP_LEVEL_FAULT, &retvalue) == RIG_OK && retvalue.s)
+    {
+        QString fault = isFault(retvalue.s) ? QString(retvalue.s) : QString();
+        if (fault != lastFault)
+        {
+            lastFault = fault;
+            if (!fault.isEmpty()) qWarning() << "Amplifier fault" << fault;
+            emit faultChanged(fault);
+        }
+    }
+
+    //* Telemetry
+    if (tx || indexCmd == 0 || indexCmd == 1)
+    {
+        if (amp_get_level(my_amp, AMP_LEVEL_PWR_FWD, &retvalue) == RIG_OK) pwrFwd = retvalue.i;
+    }
+    if (tx || indexCmd == 0 || indexCmd == 2)
+    {
+        if (amp_get_level(my_amp, AMP_LEVEL_PWR_REFLECTED, &retvalue) == RIG_OK) pwrReflected = retvalue.i;
+    }
+    if (tx || indexCmd == 0 || indexCmd == 3)
+    {
+        if (amp_get_level(my_amp, AMP_LEVEL_SWR, &retvalue) == RIG_OK) swr = retvalue.f;
+    }
+
+    emit telemetryUpdated(pwrFwd, pwrReflected, swr);
+
+    indexCmd++;
+    if (indexCmd > 3) indexCmd = 1;
+
+    pollTimer->start(tx ? pollFast : pollSlow);
+}
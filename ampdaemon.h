@@ -0,0 +1,63 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef AMPDAEMON_H
+#define AMPDAEMON_H
+
+#include <QObject>
+#include <QTimer>
+#include <QAtomicInt>
+#include <amplifier.h>
+
+
+class AmpDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AmpDaemon(QObject *parent = nullptr);
+    ~AmpDaemon();
+
+    void setTx(bool tx);    //Thread safe, selects the poll interval
+
+public slots:
+    void ampConnect(unsigned ampModel, QString ampPort, unsigned serialSpeed, int pollFast, int pollSlow);
+    void ampDisconnect();
+    void resetFault();
+
+signals:
+    void connected(int retcode, QString name);
+    void telemetryUpdated(int pwrFwd, int pwrReflected, double swr);
+    void faultChanged(QString fault);   //Empty when cleared
+
+private:
+    void ampUpdate();
+    bool isFault(QString fault);
+
+    AMP *my_amp = nullptr;
+    QTimer *pollTimer = nullptr;    //Created in the amplifier thread
+    QAtomicInt txFlag;
+    int pollFast, pollSlow;
+    int indexCmd;   //Poll index
+    int pwrFwd, pwrReflected;
+    double swr;
+    QString lastFault;
+};
+
+#endif // AMPDAEMON_H
@@ -0,0 +1,112 @@
+# CatRadio poll loop benchmark, headless
+# qmake bench/bench.pro && make
+# catradio-bench --polls 2000 --latency 5000 --jitter 2000 --baseline baseline.json
+
+QT       += core gui widgets
+QT       += serialport
+QT       += multimedia
+QT       += network
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = catradio-bench
+
+INCLUDEPATH += $$PWD/.. $$PWD/../hamlib
+
+#The whole application except main.cpp, guiUpdate is timed on a real MainWindow
+SOURCES += \
+    main.cpp \
+    ../ampdaemon.cpp \
+    ../compass.cpp \
+    ../debuglogger.cpp \
+    ../dialogamplifier.cpp \
+    ../dialogcommand.cpp \
+    ../dialogconfig.cpp \
+    ../dialogcwkeyer.cpp \
+    ../dialogmemory.cpp \
+    ../dialognetrigctl.cpp \
+    ../dialogradioinfo.cpp \
+    ../dialogrotator.cpp \
+    ../dialogsetup.cpp \
+    ../dialogstats.cpp \
+    ../dialogsurvey.cpp \
+    ../dialogvoicekeyer.cpp \
+    ../doppler.cpp \
+    ../flightrecorder.cpp \
+    ../guidata.cpp \
+    ../heatmap.cpp \
+    ../lagmonitor.cpp \
+    ../mainwindow.cpp \
+    ../netrigctl.cpp \
+    ../rigcommand.cpp \
+    ../rigdaemon.cpp \
+    ../rigdata.cpp \
+    ../rigfollow.cpp \
+    ../rigmetrics.cpp \
+    ../rigstats.cpp \
+    ../rigtape.cpp \
+    ../rigtrace.cpp \
+    ../rotdaemon.cpp \
+    ../smeter.cpp \
+    ../submeter.cpp \
+    ../survey.cpp \
+    ../vfodisplay.cpp \
+    ../winkeyer.cpp
+
+HEADERS += \
+    ../ampdaemon.h \
+    ../compass.h \
+    ../debuglogger.h \
+    ../dialogamplifier.h \
+    ../dialogcommand.h \
+    ../dialogconfig.h \
+    ../dialogcwkeyer.h \
+    ../dialogmemory.h \
+    ../dialognetrigctl.h \
+    ../dialogradioinfo.h \
+    ../dialogrotator.h \
+    ../dialogsetup.h \
+    ../dialogstats.h \
+    ../dialogsurvey.h \
+    ../dialogvoicekeyer.h \
+    ../doppler.h \
+    ../flightrecorder.h \
+    ../guidata.h \
+    ../heatmap.h \
+    ../lagmonitor.h \
+    ../mainwindow.h \
+    ../netrigctl.h \
+    ../rigcommand.h \
+    ../rigdaemon.h \
+    ../rigdata.h \
+    ../rigfollow.h \
+    ../rigmetrics.h \
+    ../rigstats.h \
+    ../rigtape.h \
+    ../rigtrace.h \
+    ../rotdaemon.h \
+    ../smeter.h \
+    ../submeter.h \
+    ../survey.h \
+    ../vfodisplay.h \
+    ../winkeyer.h
+
+FORMS += \
+    ../dialogamplifier.ui \
+    ../dialogcommand.ui \
+    ../dialogconfig.ui \
+    ../dialogcwkeyer.ui \
+    ../dialogmemory.ui \
+    ../dialognetrigctl.ui \
+    ../dialogradioinfo.ui \
+    ../dialogrotator.ui \
+    ../dialogsetup.ui \
+    ../dialogstats.ui \
+    ../dialogsurvey.ui \
+    ../dialogvoicekeyer.ui \
+    ../mainwindow.ui
+
+RESOURCES += ../qdarkstyle/dark/darkstyle.qrc
+
+LIBS += -L$$PWD/../hamlib/ -lhamlib
@@ -0,0 +1,251 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+//* Headless benchmark of the RigDaemon poll loop on the Hamlib dummy rig (model 1)
+//* Reports polls/s, command to ack latency, GUI update cost and CPU time as JSON,
+//* optionally compared against a stored baseline (exit code 1 on regression).
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QPushButton>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QVector>
+#include <QTextStream>
+
+#include <algorithm>
+#include <ctime>
+
+#include <rig.h>
+
+#include "mainwindow.h"
+#include "rigdaemon.h"
+#include "rigdata.h"
+#include "guidata.h"
+#include "rigtape.h"
+#include "rigtrace.h"
+
+extern rigSettings rigGet;
+extern rigSettings rigSet;
+extern rigCommand rigCmd;
+extern rigConnection rigCom;
+
+extern RigDaemon *rigDaemon;
+
+
+//* Percentiles of a sample set (us)
+static QJsonObject percentiles(QVector<double> samples)
+{
+    QJsonObject result;
+    if (samples.isEmpty()) return result;
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double p){ return samples.at(qMin(samples.size() - 1, int(p * samples.size()))); };
+
+    result["p50"] = at(0.50);
+    result["p90"] = at(0.90);
+    result["p99"] = at(0.99);
+    result["max"] = samples.last();
+    return result;
+}
+
+//* Compare with the baseline, higher is better for polls/s, lower for the latencies
+static bool compareBaseline(const QJsonObject &result, const QJsonObject &baseline, double tolerance)
+{
+    bool ok = true;
+    QTextStream err(stderr);
+
+    auto check = [&](QString name, double value, double base, bool higherBetter)
+    {
+        if (base <= 0) return;
+        double change = (value - base) / base * 100;
+        bool regression = higherBetter ? (change < -tolerance) : (change > tolerance);
+        err << QString("%1 %2 baseline %3 (%4%5%)%6").arg(name, -16).arg(value, 0, 'f', 1).arg(base, 0, 'f', 1).arg(change >= 0 ? "+" : "").arg(change, 0, 'f', 1).arg(regression ? "  REGRESSION" : "") << Qt::endl;
+        if (regression) ok = false;
+    };
+
+    check("polls_per_s", result["polls_per_s"].toDouble(), baseline["polls_per_s"].toDouble(), true);
+    check("poll_us p99", result["poll_us"].toObject()["p99"].toDouble(), baseline["poll_us"].toObject()["p99"].toDouble(), false);
+    check("ack_us p99", result["ack_us"].toObject()["p99"].toDouble(), baseline["ack_us"].toObject()["p99"].toDouble(), false);
+    check("gui_update_us p99", result["gui_update_us"].toObject()["p99"].toDouble(), baseline["gui_update_us"].toObject()["p99"].toDouble(), false);
+    check("cpu_percent", result["cpu_percent"].toDouble(), baseline["cpu_percent"].toDouble(), false);
+
+    return ok;
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");   //Headless, for CI
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("CatRadio poll loop benchmark");
+    parser.addHelpOption();
+    parser.addOption({"polls", "Number of polls", "n", "2000"});
+    parser.addOption({"interval", "Poll timer interval (ms), 0 = back to back", "ms", "0"});
+    parser.addOption({"command-interval", "Frequency command interval (ms)", "ms", "50"});
+    parser.addOption({"latency", "Injected latency per Hamlib call (us)", "us", "0"});
+    parser.addOption({"jitter", "Injected random jitter per Hamlib call (us)", "us", "0"});
+    parser.addOption({"full", "Full polling"});
+    parser.addOption({"output", "Write the JSON result to file", "file"});
+    parser.addOption({"baseline", "Compare with the baseline JSON", "file"});
+    parser.addOption({"save-baseline", "Save the result as the new baseline"});
+    parser.addOption({"tolerance", "Allowed regression (%)", "pct", "10"});
+    parser.addOption({"trace", "Write a Chrome trace event JSON of the run", "file"});
+    parser.process(app);
+
+    int polls = parser.value("polls").toInt();
+    bool fullPoll = parser.isSet("full");
+
+    //* Real main window, never shown, connected to the dummy rig through the Connect button (guiInit included)
+    MainWindow window;
+    rig_set_debug(RIG_DEBUG_NONE);  //The constructor opens hamlib.log
+
+    rigCom.rigModel = RIG_MODEL_DUMMY;
+    rigCom.rigPort = "";
+    rigCom.autoPowerOn = false;
+    rigCom.fullPoll = fullPoll;
+    rigCom.rigRefresh = 86400000;   //The window poll timer never fires, the benchmark drives the poll
+    window.findChild<QPushButton *>("pushButton_Connect")->setChecked(true);
+    if (!rigCom.connected || rigGet.onoff != RIG_POWER_ON)
+    {
+        QTextStream(stderr) << "Dummy rig open error" << Qt::endl;
+        return 2;
+    }
+
+    QObject::disconnect(rigDaemon, &RigDaemon::resultReady, &window, nullptr);  //guiUpdate is called and timed below
+
+    rigTape.setLatency(parser.value("latency").toInt(), parser.value("jitter").toInt());
+
+    QVector<double> pollTime, ackTime, guiTime;
+    pollTime.reserve(polls);
+    guiTime.reserve(polls);
+
+    QElapsedTimer clock;
+    freq_t target = 14000000;
+    qint64 issueTime = 0;
+    bool pending = false;
+    qint64 guiNsecs = 0;    //guiUpdate time inside the current poll
+
+    //* GUI side, the command is acknowledged when a poll reports the new frequency
+    QObject::connect(rigDaemon, &RigDaemon::resultReady, &window, [&]()
+    {
+        if (pending && rigGet.freqMain == target)
+        {
+            ackTime.append((clock.nsecsElapsed() - issueTime) / 1000.0);
+            pending = false;
+        }
+
+        qint64 start = clock.nsecsElapsed();
+        window.guiUpdate();
+        guiNsecs = clock.nsecsElapsed() - start;
+        guiTime.append(guiNsecs / 1000.0);
+    });
+
+    QTimer pollTimer;
+    QObject::connect(&pollTimer, &QTimer::timeout, [&]()
+    {
+        guiNsecs = 0;
+        qint64 start = clock.nsecsElapsed();
+        window.rigUpdate(); //resultReady is emitted in the same thread, direct call of guiUpdate
+        pollTime.append((clock.nsecsElapsed() - start - guiNsecs) / 1000.0);
+
+        if (pollTime.size() >= polls) app.quit();
+    });
+
+    QTimer commandTimer;
+    QObject::connect(&commandTimer, &QTimer::timeout, [&]()
+    {
+        if (pending) return;
+        target = (target == 14000000) ? 14001000 : 14000000;
+        rigSet.freqMain = target;
+        rigCmd.freqMain = 1;
+        issueTime = clock.nsecsElapsed();
+        pending = true;
+    });
+
+    if (parser.isSet("trace")) rigTrace.start();
+
+    std::clock_t cpuStart = std::clock();
+    clock.start();
+    pollTimer.start(parser.value("interval").toInt());
+    commandTimer.start(parser.value("command-interval").toInt());
+    app.exec();
+    double wall = clock.nsecsElapsed() / 1e9;
+    double cpu = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    if (parser.isSet("trace"))
+    {
+        rigTrace.stop();
+        rigTrace.save(parser.value("trace"));
+    }
+
+    rigTape.setLatency(0, 0);   //The window destructor closes the rig
+
+    //* Result
+    QJsonObject config;
+    config["polls"] = polls;
+    config["interval_ms"] = parser.value("interval").toInt();
+    config["command_interval_ms"] = parser.value("command-interval").toInt();
+    config["latency_us"] = parser.value("latency").toInt();
+    config["jitter_us"] = parser.value("jitter").toInt();
+    config["full_poll"] = fullPoll;
+
+    QJsonObject result;
+    result["hamlib"] = QString(hamlib_version);
+    result["config"] = config;
+    result["polls_per_s"] = pollTime.size() / wall;
+    result["poll_us"] = percentiles(pollTime);
+    result["commands"] = ackTime.size();
+    result["ack_us"] = percentiles(ackTime);
+    result["gui_update_us"] = percentiles(guiTime);
+    result["wall_s"] = wall;
+    result["cpu_s"] = cpu;
+    result["cpu_percent"] = cpu / wall * 100;
+
+    QByteArray json = QJsonDocument(result).toJson();
+    QTextStream(stdout) << json;
+
+    if (parser.isSet("output"))
+    {
+        QFile file(parser.value("output"));
+        if (file.open(QIODevice::WriteOnly)) file.write(json);
+    }
+
+    if (!parser.isSet("baseline")) return 0;
+
+    QFile baselineFile(parser.value("baseline"));
+    if (parser.isSet("save-baseline"))
+    {
+        if (baselineFile.open(QIODevice::WriteOnly)) baselineFile.write(json);
+        return 0;
+    }
+    if (!baselineFile.open(QIODevice::ReadOnly))
+    {
+        QTextStream(stderr) << "No baseline " << baselineFile.fileName() << Qt::endl;
+        return 0;
+    }
+
+    QJsonObject baseline = QJsonDocument::fromJson(baselineFile.readAll()).object();
+    return compareBaseline(result, baseline, parser.value("tolerance").toDouble()) ? 0 : 1;
+}
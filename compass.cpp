@@ -0,0 +1,155 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "compass.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <math.h>
+
+Compass::Compass(QWidget *parent) : QWidget(parent)
+{
+    lineColor = QColor(Qt::black);
+    bgColor = QColor(Qt::white);
+    needleColor = QColor(Qt::red);
+
+    azimuth = 0;
+    target = -1;
+    moving = false;
+}
+
+void Compass::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+
+    int side = qMin(width(), height());
+    painter.translate(width() / 2, height() / 2);
+    painter.scale(side / 200.0, side / 200.0);  //200x200 logical coordinates, centered
+
+    drawDial(&painter);
+    drawNeedle(&painter);
+}
+
+void Compass::drawDial(QPainter *painter)
+{
+    painter->save();
+
+    painter->setPen(QPen(lineColor, 1));
+    painter->setBrush(bgColor);
+    painter->drawEllipse(QPointF(0, 0), 96, 96);
+
+    //Ticks every 10 deg, long every 30 deg
+    for (int i = 0; i < 360; i += 10)
+    {
+        if (i % 30 == 0) painter->drawLine(0, -96, 0, -84);
+        else painter->drawLine(0, -96, 0, -90);
+        painter->rotate(10);
+    }
+
+    //Cardinal points
+    QFont font = painter->font();
+    font.setPointSize(10);
+    painter->setFont(font);
+    const char *cardinal[4] = {"N", "E", "S", "W"};
+    for (int i = 0; i < 4; i++)
+    {
+        double angle = i * M_PI / 2;
+        QRectF rect(70 * sin(angle) - 10, -70 * cos(angle) - 10, 20, 20);
+        painter->drawText(rect, Qt::AlignCenter, cardinal[i]);
+    }
+
+    painter->drawText(QRectF(-40, 20, 80, 20), Qt::AlignCenter, QString::number(azimuth, 'f', 0) + "°");
+
+    painter->restore();
+}
+
+void Compass::drawNeedle(QPainter *painter)
+{
+    painter->save();
+
+    if (target >= 0)    //Target marker
+    {
+        painter->save();
+        painter->rotate(target);
+        painter->setPen(QPen(lineColor, 1, Qt::DashLine));
+        painter->drawLine(0, 0, 0, -84);
+        painter->restore();
+    }
+
+    painter->rotate(azimuth);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(moving ? needleColor.lighter(130) : needleColor);
+    QPointF needle[3] = {QPointF(-5, 0), QPointF(0, -80), QPointF(5, 0)};
+    painter->drawPolygon(needle, 3);
+    painter->setBrush(lineColor);
+    painter->drawEllipse(QPointF(0, 0), 4, 4);
+
+    painter->restore();
+}
+
+void Compass::mousePressEvent(QMouseEvent *event)
+{
+    double dx = event->pos().x() - width() / 2.0;
+    double dy = event->pos().y() - height() / 2.0;
+    if (dx == 0 && dy == 0) return;
+
+    double az = atan2(dx, -dy) * 180.0 / M_PI;
+    if (az < 0) az += 360;
+
+    emit azimuthClicked(qRound(az));
+}
+
+void Compass::setAzimuth(double value)
+{
+    if (value == azimuth) return;
+    azimuth = value;
+    update();
+}
+
+void Compass::setTarget(double value)
+{
+    target = value;
+    update();
+}
+
+void Compass::setMoving(bool moving)
+{
+    if (this->moving == moving) return;
+    this->moving = moving;
+    if (!moving) target = -1;   //Target reached or stopped
+    update();
+}
+
+void Compass::setBgColor(QColor color)
+{
+    bgColor = color;
+    update();
+}
+
+void Compass::setLineColor(QColor color)
+{
+    lineColor = color;
+    update();
+}
+
+void Compass::setNeedleColor(QColor color)
+{
+    needleColor = color;
+    update();
+}
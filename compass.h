@@ -0,0 +1,60 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef COMPASS_H
+#define COMPASS_H
+
+#include <QWidget>
+
+class Compass : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Compass(QWidget *parent = nullptr);
+
+public slots:
+    void setAzimuth(double value);
+    void setTarget(double value);
+    void setMoving(bool moving);
+
+    void setBgColor(QColor color);
+    void setLineColor(QColor color);
+    void setNeedleColor(QColor color);
+
+signals:
+    void azimuthClicked(double azimuth);    //Azimuth selected with the mouse
+
+protected:
+    void paintEvent(QPaintEvent *);
+    void mousePressEvent(QMouseEvent *event);
+    void drawDial(QPainter *painter);
+    void drawNeedle(QPainter *painter);
+
+private:
+    double azimuth; //Current azimuth (deg)
+    double target;  //Go-to azimuth (deg), negative if none
+    bool moving;
+
+    QColor bgColor; //background color
+    QColor lineColor;   //line and text color
+    QColor needleColor; //needle color
+};
+
+#endif // COMPASS_H
@@ -20,80 +20,379 @@
 #include "debuglogger.h"
 
 #include <QDateTime>
-#include <QTextStream>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QThread>
+#include <QFileInfo>
 #include <QDebug>
+#include <cstring>
+
+
+static quint64 dequeuePos = 0;  //Writer thread only, records taken from the ring
+
+//* Background writer, drains the ring every LOG_FLUSH_MS with the file kept open
+class debugLogWriter : public QThread
+{
+public:
+    QAtomicInteger<int> running = 1;
+    QAtomicInteger<quint64> flushTarget = 0;    //Enqueue position a waiting thread needs on file
+    QAtomicInteger<quint64> drained = 0;    //Records written and flushed, dequeue position
+
+protected:
+    void run() override
+    {
+        QByteArray batch;
+        while (true)
+        {
+            bool stop = !running.loadAcquire();
+            batch.clear();
+            while (debugLogger::dequeue(batch) && batch.size() < 65536) {}
+
+            if (!batch.isEmpty())
+            {
+                debugLogger::logFile.write(batch);
+                debugLogger::logFile.flush();
+                drained.storeRelease(dequeuePos);
+                if (debugLogger::logFile.size() > LOG_MAX_SIZE) debugLogger::rotate();
+                continue;   //More may be queued
+            }
+
+            if (stop) break;
+            for (int t = 0; t < LOG_FLUSH_MS && running.loadRelaxed() && flushTarget.loadAcquire() <= drained.loadRelaxed(); t += 10) msleep(10);
+        }
+    }
+};
 
 
 QFile debugLogger::logFile;
-QMutex debugLogger::mutex;
-QtMsgType debugLogger::currentDebugLevel = QtInfoMsg;   //defaul debug level
+bool debugLogger::logBinary = false;
+QAtomicInteger<int> debugLogger::currentDebugLevel = QtInfoMsg;   //defaul debug level
+debugLogger::logRecord debugLogger::ring[LOG_RING];
+QAtomicInteger<quint64> debugLogger::enqueuePos = 0;
+QAtomicInteger<quint64> debugLogger::dropped = 0;
+debugLogWriter *debugLogger::writer = nullptr;
+
+static QElapsedTimer logClock;  //Record time base
+static qint64 logWallStart; //ms since epoch at logClock start
+
+//Writer thread only
+static qint64 lastTime = 0; //Binary, previous record time
+static QHash<const void *, quint32> stringId;   //Binary, interned static strings
 
 
 debugLogger::debugLogger() {}
 
 
-void debugLogger::install(QString fileName) //Install the debug message handler
+//* Binary file header: magic, wall clock (ms) and monotonic time (ns) of the file start
+static QByteArray binaryHeader(qint64 time)
+{
+    QByteArray header(LOG_MAGIC);
+    qint64 wall = logWallStart + time / 1000000;
+    for (int b = 0; b < 8; b++) header.append(char(wall >> (8 * b)));
+    for (int b = 0; b < 8; b++) header.append(char(time >> (8 * b)));
+    return header;
+}
+
+
+void debugLogger::install(QString fileName, bool binary) //Install the debug message handler
 {
+    for (quint64 i = 0; i < LOG_RING; i++) ring[i].sequence.storeRelaxed(i);
+
+    logClock.start();
+    logWallStart = QDateTime::currentMSecsSinceEpoch();
+    logBinary = binary;
+
     logFile.setFileName(fileName);    //Set debug log file
-    if (logFile.open(QIODevice::WriteOnly | QIODevice::Text)) logFile.close();
+    if (!logFile.open(QIODevice::WriteOnly | QIODevice::Truncate | (binary ? QIODevice::NotOpen : QIODevice::Text))) return;
+    if (binary) logFile.write(binaryHeader(0));
+
+    writer = new debugLogWriter;
+    writer->drained.storeRelaxed(dequeuePos);
+    writer->start(QThread::LowPriority);
 
     qInstallMessageHandler(debugLogger::messageHandler);    //Message handler
 }
 
 
+void debugLogger::uninstall()
+{
+    if (!writer) return;
+
+    qInstallMessageHandler(nullptr);
+    writer->running.storeRelease(0);
+    writer->wait();
+    delete writer;
+    writer = nullptr;
+
+    logFile.close();
+}
+
+
 void debugLogger::setDebugLevel(QtMsgType level)    //Select debug level
 {
-    //QMutexLocker locker(&mutex);
-    currentDebugLevel = level;
+    currentDebugLevel.storeRelaxed(level);
 }
 
 
-void debugLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) //Message handler
+//* Rename catradio.log to catradio.log.1, shifting the older ones, and start a new file
+void debugLogger::rotate()
 {
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzztt");
-    QString txt;
+    QString fileName = logFile.fileName();
+    logFile.close();
+
+    QFile::remove(QString("%1.%2").arg(fileName).arg(LOG_FILES));
+    for (int n = LOG_FILES - 1; n >= 1; n--) QFile::rename(QString("%1.%2").arg(fileName).arg(n), QString("%1.%2").arg(fileName).arg(n + 1));
+    QFile::rename(fileName, fileName + ".1");
 
+    logFile.open(QIODevice::WriteOnly | QIODevice::Truncate | (logBinary ? QIODevice::NotOpen : QIODevice::Text));
+    if (logBinary)  //Each file can be decoded on its own
+    {
+        lastTime = logClock.nsecsElapsed();
+        stringId.clear();
+        logFile.write(binaryHeader(lastTime));
+    }
+}
+
+
+//* Expand a format record, printf style conversions with the queued arguments
+static QString formatArgs(const char *format, const logArg *args, int argc)
+{
+    QString text;
+    int n = 0;
+
+    for (const char *p = format; *p; p++)
+    {
+        if (*p != '%' || !p[1])
+        {
+            text += QLatin1Char(*p);
+            continue;
+        }
+
+        p++;
+        if (*p == '%' || n >= argc)
+        {
+            text += QLatin1Char('%');
+            if (*p != '%') text += QLatin1Char(*p);
+            continue;
+        }
+
+        const logArg &arg = args[n++];
+        if (arg.tag == LOG_ARG_STRING) text += QString::fromUtf8(arg.s ? arg.s : "(null)");
+        else if (arg.tag == LOG_ARG_DOUBLE) text += QString::number(arg.f, *p == 'g' ? 'g' : 'f', *p == 'g' ? 6 : 3);
+        else if (*p == 'x') text += QString::number(arg.i, 16);
+        else text += QString::number(arg.i);
+    }
+
+    return text;
+}
+
+
+void debugLogger::encodeText(QByteArray &batch, const logRecord &rec)
+{
+    static const char *typeName[5] = {"Debug", "Warning", "Critical", "Fatal", "Info"};
+
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(logWallStart + rec.time / 1000000).toString("yyyy-MM-dd hh:mm:ss.zzztt");
+    QString msg = rec.format ? formatArgs(rec.format, rec.args, rec.argc) : rec.msg;
     QString contextInfo = QString(" (%1:%2 %3 [%4])")
-        .arg(context.file ? context.file : "unknown")
-        .arg(context.line)
-        .arg(context.function ? context.function : "unknown")
-        .arg(context.category ? context.category : "default");
+        .arg(rec.file ? rec.file : "unknown")
+        .arg(rec.line)
+        .arg(rec.function ? rec.function : "unknown")
+        .arg(rec.category ? rec.category : "default");
 
-    switch (type)
+    batch += QString("%1: [%2] %3 %4\n").arg(timestamp, typeName[rec.type <= QtInfoMsg ? rec.type : 0], msg, contextInfo).toUtf8();
+}
+
+
+static void putVarint(QByteArray &batch, quint64 value)
+{
+    while (value >= 0x80)
+    {
+        batch.append(char(value | 0x80));
+        value >>= 7;
+    }
+    batch.append(char(value));
+}
+
+//* Interned by address, the string is written once per file
+static quint32 putString(QByteArray &batch, const char *str)
+{
+    if (!str) return 0;
+
+    auto i = stringId.constFind(str);
+    if (i != stringId.constEnd()) return i.value();
+
+    quint32 id = stringId.size() + 1;
+    stringId.insert(str, id);
+
+    size_t length = strlen(str);
+    batch.append(char(LOG_TAG_STRING));
+    putVarint(batch, id);
+    putVarint(batch, length);
+    batch.append(str, int(length));
+    return id;
+}
+
+
+void debugLogger::encodeBinary(QByteArray &batch, const logRecord &rec)
+{
+    //String definitions go before the record that uses them
+    quint32 category = putString(batch, rec.category);
+    quint64 dt = quint64(qMax(Q_INT64_C(0), rec.time - lastTime));
+    lastTime = qMax(lastTime, rec.time);
+
+    if (rec.format)
+    {
+        quint32 format = putString(batch, rec.format);
+        quint32 argString[LOG_ARGS] = {};
+        for (int n = 0; n < rec.argc; n++) if (rec.args[n].tag == LOG_ARG_STRING) argString[n] = putString(batch, rec.args[n].s);
+
+        batch.append(char(LOG_TAG_FORMAT));
+        batch.append(char(rec.type));
+        putVarint(batch, dt);
+        putVarint(batch, category);
+        putVarint(batch, format);
+        putVarint(batch, rec.argc);
+        for (int n = 0; n < rec.argc; n++)
+        {
+            const logArg &arg = rec.args[n];
+            batch.append(arg.tag);
+            if (arg.tag == LOG_ARG_STRING) putVarint(batch, argString[n]);
+            else if (arg.tag == LOG_ARG_DOUBLE)
+            {
+                quint64 bits;
+                memcpy(&bits, &arg.f, 8);
+                for (int b = 0; b < 8; b++) batch.append(char(bits >> (8 * b)));
+            }
+            else putVarint(batch, (quint64(arg.i) << 1) ^ quint64(arg.i >> 63));   //zigzag
+        }
+    }
+    else
+    {
+        quint32 file = putString(batch, rec.file);
+        quint32 function = putString(batch, rec.function);
+        QByteArray msg = rec.msg.toUtf8();
+
+        batch.append(char(LOG_TAG_MESSAGE));
+        batch.append(char(rec.type));
+        putVarint(batch, dt);
+        putVarint(batch, category);
+        putVarint(batch, file);
+        putVarint(batch, function);
+        putVarint(batch, quint32(rec.line));
+        putVarint(batch, msg.size());
+        batch.append(msg);
+    }
+}
+
+
+//* Single consumer, encodes one record into the batch
+bool debugLogger::dequeue(QByteArray &batch)
+{
+    logRecord &rec = ring[dequeuePos & (LOG_RING - 1)];
+    if (rec.sequence.loadAcquire() != dequeuePos + 1) return false;   //Empty
+
+    if (logBinary) encodeBinary(batch, rec);
+    else encodeText(batch, rec);
+
+    rec.msg.clear();
+    rec.sequence.storeRelease(dequeuePos + LOG_RING);
+    dequeuePos++;
+
+    quint64 lost = dropped.fetchAndStoreRelaxed(0);
+    if (lost)
+    {
+        if (logBinary)
+        {
+            batch.append(char(LOG_TAG_DROPPED));
+            putVarint(batch, lost);
+        }
+        else batch += QString("%1: [Warning] %2 log messages dropped, queue full\n").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzztt")).arg(lost).toUtf8();
+    }
+
+    return true;
+}
+
+
+//* Bounded MPSC queue slot, nullptr if full
+debugLogger::logRecord *debugLogger::reserve(quint64 *pos)
+{
+    *pos = enqueuePos.loadRelaxed();
+    while (true)
+    {
+        logRecord *rec = &ring[*pos & (LOG_RING - 1)];
+        qint64 diff = qint64(rec->sequence.loadAcquire() - *pos);
+        if (diff == 0)
+        {
+            if (enqueuePos.testAndSetRelaxed(*pos, *pos + 1, *pos)) return rec;
+        }
+        else if (diff < 0)  //Full
+        {
+            dropped.fetchAndAddRelaxed(1);
+            return nullptr;
+        }
+        else *pos = enqueuePos.loadRelaxed();
+    }
+}
+
+
+void debugLogger::push(QtMsgType type, const char *category, const char *format, const logArg *args, int argc)
+{
+    quint64 pos;
+    logRecord *rec = reserve(&pos);
+    if (!rec) return;
+
+    rec->time = logClock.nsecsElapsed();
+    rec->type = type;
+    rec->format = format;
+    rec->file = nullptr;
+    rec->function = nullptr;
+    rec->category = category;
+    rec->line = 0;
+    rec->argc = argc;
+    for (int n = 0; n < argc; n++) rec->args[n] = args[n];
+    rec->sequence.storeRelease(pos + 1);
+}
+
+
+//* The level is checked before any formatting
+void debugLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg) //Message handler
+{
+    if (type == QtDebugMsg)
     {
-    case QtDebugMsg:    //0
         fprintf(stderr, "[Debug] %s\n", msg.toLocal8Bit().constData());
         fflush(stderr);
-        txt = QString("%1: [Debug] %2 %3").arg(timestamp, msg, contextInfo);
-        break;
-    case QtInfoMsg:     //4
-        txt = QString("%1: [Info] %2 %3").arg(timestamp, msg, contextInfo);
-        break;
-    case QtWarningMsg:  //1
-        txt = QString("%1: [Warning] %2 %3").arg(timestamp, msg, contextInfo);
-        break;
-    case QtCriticalMsg: //2
-        txt = QString("%1: [Critical] %2 %3").arg(timestamp, msg, contextInfo);
-        break;
-    case QtFatalMsg:    //3
-        txt = QString("%1: [Fatal] %2 %3").arg(timestamp, msg, contextInfo);
-        break;
     }
 
-    QMutexLocker locker(&mutex);
-
-    if (type <= currentDebugLevel)
+    quint64 flushTo = 0;    //Enqueue position just past this record
+    if (type <= currentDebugLevel.loadRelaxed())
     {
-        if (logFile.open(QIODevice::Append | QIODevice::Text))
+        quint64 pos;
+        logRecord *rec = reserve(&pos);
+        if (rec)
         {
-            QTextStream out(&logFile);
-            out << txt << Qt::endl;
-            logFile.close();
+            rec->time = logClock.nsecsElapsed();
+            rec->type = type;
+            rec->msg = msg;
+            rec->format = nullptr;
+            rec->file = context.file;
+            rec->function = context.function;
+            rec->category = context.category;
+            rec->line = context.line;
+            rec->argc = 0;
+            rec->sequence.storeRelease(pos + 1);
+            flushTo = pos + 1;
         }
     }
 
     if (type == QtFatalMsg)
     {
+        if (writer) //Give the writer a chance to save the last records, this one included
+        {
+            if (!flushTo) flushTo = enqueuePos.loadAcquire();
+            quint64 target = writer->flushTarget.loadRelaxed();
+            while (target < flushTo && !writer->flushTarget.testAndSetRelease(target, flushTo, target)) {}
+            for (int t = 0; t < 100 && writer->drained.loadAcquire() < flushTo; t++) QThread::msleep(10);
+        }
         abort();
     }
 }
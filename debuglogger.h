@@ -22,23 +22,103 @@
 
 #include <QString>
 #include <QFile>
-#include <QMutex>
+#include <QAtomicInteger>
 #include <QtGlobal>
 
+#define LOG_RING 8192   //Queued records, power of 2
+#define LOG_FLUSH_MS 200    //Max delay before a record reaches the file
+#define LOG_MAX_SIZE 5000000    //Rotation size (bytes)
+#define LOG_FILES 3 //Rotated files kept, catradio.log.1 ... .3
+#define LOG_ARGS 6  //Max arguments of a format record
+
+//Binary log, see tools/logdecode
+#define LOG_MAGIC "CRBLOG1\n"
+#define LOG_TAG_STRING 1    //id, length, bytes
+#define LOG_TAG_MESSAGE 2   //type, dt, category, file, function, line, length, bytes
+#define LOG_TAG_FORMAT 3    //type, dt, category, format, argc, args
+#define LOG_TAG_DROPPED 4   //count
+#define LOG_ARG_INT 'i'     //zigzag varint
+#define LOG_ARG_DOUBLE 'f'  //8 bytes little endian
+#define LOG_ARG_STRING 's'  //string id
+
+
+//* Argument of a format record, strings must be static
+struct logArg
+{
+    char tag;
+    union
+    {
+        qint64 i;
+        double f;
+        const char *s;
+    };
+
+    logArg() : tag(LOG_ARG_INT), i(0) {}
+    logArg(int value) : tag(LOG_ARG_INT), i(value) {}
+    logArg(unsigned value) : tag(LOG_ARG_INT), i(value) {}
+    logArg(long value) : tag(LOG_ARG_INT), i(value) {}
+    logArg(unsigned long value) : tag(LOG_ARG_INT), i(qint64(value)) {}
+    logArg(long long value) : tag(LOG_ARG_INT), i(value) {}
+    logArg(unsigned long long value) : tag(LOG_ARG_INT), i(qint64(value)) {}
+    logArg(double value) : tag(LOG_ARG_DOUBLE), f(value) {}
+    logArg(const char *value) : tag(LOG_ARG_STRING), s(value) {}
+};
+
+
+class debugLogWriter;
 
 class debugLogger
 {
 public:
     debugLogger();
-    static void install(QString fileName);
+    static void install(QString fileName, bool binary = false);
+    static void uninstall();    //Write the pending records and close the file
     static void setDebugLevel(QtMsgType level);
 
+    //* Hot path logging, format and arguments are queued as is and expanded by the writer (%d %u %x %f %g %s)
+    //* e.g. debugLogger::log(QtInfoMsg, "hamlib", "%s error %d", tape_call_name(call), retcode);
+    template<typename... Args>
+    static void log(QtMsgType type, const char *category, const char *format, Args... args)
+    {
+        static_assert(sizeof...(args) <= LOG_ARGS, "Too many log arguments");
+        if (type > currentDebugLevel.loadRelaxed() || !writer) return;
+        const logArg list[sizeof...(args) + 1] = {logArg(args)...};
+        push(type, category, format, list, sizeof...(args));
+    }
+
 private:
+    struct logRecord
+    {
+        QAtomicInteger<quint64> sequence;
+        qint64 time;    //ns since install, monotonic
+        QtMsgType type;
+        QString msg;
+        const char *format; //Format record if not null
+        const char *file;   //Static strings from the message context
+        const char *function;
+        const char *category;
+        int line;
+        int argc;
+        logArg args[LOG_ARGS];
+    };
+
     static QFile logFile;
-    static QMutex mutex;
-    static QtMsgType currentDebugLevel;
+    static bool logBinary;
+    static QAtomicInteger<int> currentDebugLevel;
+    static logRecord ring[LOG_RING];
+    static QAtomicInteger<quint64> enqueuePos;
+    static QAtomicInteger<quint64> dropped;
+    static debugLogWriter *writer;
 
     static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+    static logRecord *reserve(quint64 *pos);
+    static void push(QtMsgType type, const char *category, const char *format, const logArg *args, int argc);
+    static bool dequeue(QByteArray &batch);
+    static void encodeText(QByteArray &batch, const logRecord &rec);
+    static void encodeBinary(QByteArray &batch, const logRecord &rec);
+    static void rotate();
+
+    friend class debugLogWriter;
 };
 
 #endif // DEBUGLOGGER_H
@@ -0,0 +1,126 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "dialogamplifier.h"
+#include "ui_dialogamplifier.h"
+
+#include <QSettings>
+#include <QSignalBlocker>
+
+#include "rigdata.h"
+#include "ampdaemon.h"
+
+
+extern ampConnection ampCom;
+
+
+DialogAmplifier::DialogAmplifier(AmpDaemon *ampDaemonPtr, QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::DialogAmplifier)
+    , ampDaemon(ampDaemonPtr)
+{
+    ui->setupUi(this);
+
+    ui->spinBox_ampModel->setValue(ampCom.ampModel);
+    ui->lineEdit_ampPort->setText(ampCom.ampPort);
+
+    connect(ampDaemon, &AmpDaemon::connected, this, &DialogAmplifier::on_ampConnected);
+    connect(ampDaemon, &AmpDaemon::telemetryUpdated, this, &DialogAmplifier::on_ampTelemetryUpdated);
+    connect(ampDaemon, &AmpDaemon::faultChanged, this, &DialogAmplifier::on_ampFaultChanged);
+}
+
+DialogAmplifier::~DialogAmplifier()
+{
+    delete ui;
+}
+
+
+void DialogAmplifier::on_ampConnected(int retcode, QString name)
+{
+    const QSignalBlocker blocker(ui->pushButton_Connect);
+
+    if (retcode != RIG_OK)
+    {
+        ui->pushButton_Connect->setChecked(false);
+        ui->label_status->setText(QString("Connection error: ") + rigerror(retcode));
+    }
+    else
+    {
+        ui->pushButton_Connect->setChecked(true);
+        ui->label_status->setText("Connected to " + name);
+    }
+}
+
+
+void DialogAmplifier::on_ampTelemetryUpdated(int pwrFwd, int pwrReflected, double swr)
+{
+    ui->label_pwrFwdValue->setText(QString::number(pwrFwd) + " W");
+    ui->label_pwrReflectedValue->setText(QString::number(pwrReflected) + " W");
+    ui->label_swrValue->setText(QString::number(swr, 'f', 1));
+}
+
+
+void DialogAmplifier::on_ampFaultChanged(QString fault)
+{
+    if (fault.isEmpty())
+    {
+        ui->label_faultValue->setText("None");
+        ui->label_faultValue->setStyleSheet("QLabel {}");
+    }
+    else
+    {
+        ui->label_faultValue->setText(fault);
+        ui->label_faultValue->setStyleSheet("QLabel {background-color: red}");
+    }
+}
+
+
+void DialogAmplifier::on_pushButton_Connect_toggled(bool checked)
+{
+    if (checked)
+    {
+        ampCom.ampModel = ui->spinBox_ampModel->value();
+        ampCom.ampPort = ui->lineEdit_ampPort->text();
+
+        //* Save settings in catradio.ini
+        QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+        configFile.setValue("Amplifier/ampModel", ampCom.ampModel);
+        configFile.setValue("Amplifier/ampPort", ampCom.ampPort);
+
+        ampConnection conf = ampCom;
+        AmpDaemon *daemon = ampDaemon;
+        QMetaObject::invokeMethod(ampDaemon, [daemon, conf]()
+        {
+            daemon->ampConnect(conf.ampModel, conf.ampPort, conf.serialSpeed, conf.pollFast, conf.pollSlow);
+        }, Qt::QueuedConnection);
+    }
+    else
+    {
+        AmpDaemon *daemon = ampDaemon;
+        QMetaObject::invokeMethod(ampDaemon, [daemon](){ daemon->ampDisconnect(); }, Qt::QueuedConnection);
+        ui->label_status->setText("Disconnected");
+    }
+}
+
+
+void DialogAmplifier::on_pushButton_ResetFault_clicked()
+{
+    AmpDaemon *daemon = ampDaemon;
+    QMetaObject::invokeMethod(ampDaemon, [daemon](){ daemon->resetFault(); }, Qt::QueuedConnection);
+}
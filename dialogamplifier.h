@@ -0,0 +1,53 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DIALOGAMPLIFIER_H
+#define DIALOGAMPLIFIER_H
+
+#include <QDialog>
+
+class AmpDaemon;
+
+
+namespace Ui {
+class DialogAmplifier;
+}
+
+class DialogAmplifier : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogAmplifier(AmpDaemon *ampDaemonPtr = nullptr, QWidget *parent = nullptr);
+    ~DialogAmplifier();
+
+private slots:
+    void on_ampConnected(int retcode, QString name);
+    void on_ampTelemetryUpdated(int pwrFwd, int pwrReflected, double swr);
+    void on_ampFaultChanged(QString fault);
+
+    void on_pushButton_Connect_toggled(bool checked);
+    void on_pushButton_ResetFault_clicked();
+
+private:
+    Ui::DialogAmplifier *ui;
+    AmpDaemon *ampDaemon;
+};
+
+#endif // DIALOGAMPLIFIER_H
@@ -34,6 +34,7 @@
 
 extern rigConnection rigCom;
 extern guiConfig guiConf;
+extern int rigSessActive;
 
 
 QString rigListFile = "rig.lst";    //Text file containing the list of rig supported by hamlib
@@ -94,6 +95,8 @@ DialogConfig::DialogConfig(QWidget *parent) :
     ui->checkBox_fullPoll->setChecked(rigCom.fullPoll);
     ui->checkBox_autoConnect->setChecked(rigCom.autoConnect);
     ui->checkBox_autoPowerOn->setChecked(rigCom.autoPowerOn);
+    ui->checkBox_standby->setChecked(rigCom.standby);
+    ui->lineEdit_profile->setText(rigCom.profile);
     ui->checkBox_rigModelSort->setChecked(guiConf.rigModelSort);
 }
 
@@ -279,9 +282,13 @@ void DialogConfig::on_buttonBox_accepted()
     rigCom.fullPoll = ui->checkBox_fullPoll->isChecked();
     rigCom.autoConnect = ui->checkBox_autoConnect->isChecked();
     rigCom.autoPowerOn = ui->checkBox_autoPowerOn->isChecked();
+    rigCom.standby = ui->checkBox_standby->isChecked();
+    if (!ui->lineEdit_profile->text().trimmed().isEmpty()) rigCom.profile = ui->lineEdit_profile->text().trimmed();
 
     //* Save settings in catradio.ini
     QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+    configFile.setValue("rigModelSort", guiConf.rigModelSort);
+    if (rigSessActive) configFile.beginGroup(QString("Rig%1").arg(rigSessActive+1));  //Additional rig sessions
     configFile.setValue("rigModel", rigCom.rigModel);
     configFile.setValue("rigPort", rigCom.rigPort);
     configFile.setValue("serialSpeed", ui->comboBox_serialSpeed->currentText());
@@ -295,7 +302,9 @@ void DialogConfig::on_buttonBox_accepted()
     configFile.setValue("fullPolling", ui->checkBox_fullPoll->isChecked());
     configFile.setValue("autoConnect", ui->checkBox_autoConnect->isChecked());
     configFile.setValue("autoPowerOn", ui->checkBox_autoPowerOn->isChecked());
-    configFile.setValue("rigModelSort", guiConf.rigModelSort);
+    configFile.setValue("pollBudget", rigCom.pollBudget);
+    configFile.setValue("profileName", rigCom.profile);
+    configFile.setValue("standby", rigCom.standby);
 }
 
 
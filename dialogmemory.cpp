@@ -0,0 +1,273 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "dialogmemory.h"
+#include "ui_dialogmemory.h"
+
+#include <QSettings>
+#include <QTableWidgetItem>
+#include <QDebug>
+
+
+#define MEM_COL_FREQ 0
+#define MEM_COL_MODE 1
+#define MEM_COL_WIDTH 2
+#define MEM_COL_TXFREQ 3
+#define MEM_COL_SHIFT 4
+#define MEM_COL_OFFSET 5
+#define MEM_COL_CTCSS 6
+#define MEM_COL_NAME 7
+
+
+//* Compare the fields written by RigDaemon::memoryWrite
+static bool sameChannel(const rigChannel &a, const rigChannel &b)
+{
+    if (a.freq == 0 || b.freq == 0) return a.freq == b.freq;    //Blank
+
+    bool splitOn = (a.split == RIG_SPLIT_ON);
+
+    return a.freq == b.freq && a.mode == b.mode && a.width == b.width && splitOn == (b.split == RIG_SPLIT_ON) && (!splitOn || a.txFreq == b.txFreq)
+           && a.rptrShift == b.rptrShift && a.rptrOffs == b.rptrOffs && a.ctcss == b.ctcss && a.name == b.name;
+}
+
+
+DialogMemory::DialogMemory(RIG *rig, QList<rigChannel> *buffer, QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::DialogMemory)
+    , my_rig(rig)
+    , memoryBuffer(buffer)
+    , busy(0)
+{
+    ui->setupUi(this);
+
+    setWindowTitle(QString("Memory channels - %1").arg(my_rig->caps->model_name));
+
+    //* Memory channel list from the rig caps
+    for (int i = 0; i < HAMLIB_CHANLSTSIZ && !RIG_IS_CHAN_END(my_rig->caps->chan_list[i]); i++)
+    {
+        if (my_rig->caps->chan_list[i].type != RIG_MTYPE_MEM) continue;
+        for (int n = my_rig->caps->chan_list[i].startc; n <= my_rig->caps->chan_list[i].endc; n++)
+        {
+            if (!cache.contains(n))
+            {
+                rigChannel mem = {};
+                mem.num = n;
+                cache.insert(n, mem);
+            }
+        }
+    }
+
+    loadCache();
+    setTable();
+    setBusy(0);
+
+    if (cache.isEmpty()) ui->label_status->setText("No memory channels");
+    else ui->label_status->setText(QString("%1 channels, cached").arg(cache.size()));
+}
+
+DialogMemory::~DialogMemory()
+{
+    delete ui;
+}
+
+
+//* Cache file, one per rig model
+QString DialogMemory::cacheFileName()
+{
+    return QString("memory%1.ini").arg(my_rig->caps->rig_model);
+}
+
+void DialogMemory::loadCache()
+{
+    QSettings cacheFile(cacheFileName(), QSettings::IniFormat);
+
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+    {
+        cacheFile.beginGroup(QString("Channel%1").arg(it.key()));
+        if (cacheFile.contains("freq"))
+        {
+            it->freq = cacheFile.value("freq", 0).toDouble();
+            it->mode = rig_parse_mode(cacheFile.value("mode", "").toString().toLatin1());
+            it->width = cacheFile.value("width", 0).toInt();
+            it->txFreq = cacheFile.value("txFreq", 0).toDouble();
+            it->split = cacheFile.value("split", false).toBool() ? RIG_SPLIT_ON : RIG_SPLIT_OFF;
+            it->rptrShift = rig_parse_rptr_shift(cacheFile.value("shift", "").toString().toLatin1());
+            it->rptrOffs = cacheFile.value("offset", 0).toInt();
+            it->ctcss = cacheFile.value("ctcss", 0).toUInt();
+            it->name = cacheFile.value("name", "").toString();
+        }
+        cacheFile.endGroup();
+    }
+}
+
+void DialogMemory::saveCache()
+{
+    QSettings cacheFile(cacheFileName(), QSettings::IniFormat);
+
+    for (auto it = cache.cbegin(); it != cache.cend(); ++it)
+    {
+        cacheFile.beginGroup(QString("Channel%1").arg(it.key()));
+        cacheFile.setValue("freq", (double)it->freq);
+        cacheFile.setValue("mode", rig_strrmode(it->mode));
+        cacheFile.setValue("width", (int)it->width);
+        cacheFile.setValue("txFreq", (double)it->txFreq);
+        cacheFile.setValue("split", it->split == RIG_SPLIT_ON);
+        cacheFile.setValue("shift", rig_strptrshift(it->rptrShift));
+        cacheFile.setValue("offset", (int)it->rptrOffs);
+        cacheFile.setValue("ctcss", it->ctcss);
+        cacheFile.setValue("name", it->name);
+        cacheFile.endGroup();
+    }
+}
+
+
+//* Fill the table from the cache
+void DialogMemory::setTable()
+{
+    ui->tableWidget->setRowCount(cache.size());
+
+    int row = 0;
+    for (auto it = cache.cbegin(); it != cache.cend(); ++it, row++)
+    {
+        const rigChannel &mem = *it;
+        bool empty = (mem.freq == 0);
+
+        ui->tableWidget->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(mem.num)));
+        ui->tableWidget->setItem(row, MEM_COL_FREQ, new QTableWidgetItem(empty ? "" : QString::number(mem.freq, 'f', 0)));
+        ui->tableWidget->setItem(row, MEM_COL_MODE, new QTableWidgetItem(empty ? "" : rig_strrmode(mem.mode)));
+        ui->tableWidget->setItem(row, MEM_COL_WIDTH, new QTableWidgetItem(empty ? "" : QString::number(mem.width)));
+        ui->tableWidget->setItem(row, MEM_COL_TXFREQ, new QTableWidgetItem(empty || mem.split != RIG_SPLIT_ON ? "" : QString::number(mem.txFreq, 'f', 0)));
+        ui->tableWidget->setItem(row, MEM_COL_SHIFT, new QTableWidgetItem(empty ? "" : rig_strptrshift(mem.rptrShift)));
+        ui->tableWidget->setItem(row, MEM_COL_OFFSET, new QTableWidgetItem(empty || !mem.rptrOffs ? "" : QString::number(mem.rptrOffs)));
+        ui->tableWidget->setItem(row, MEM_COL_CTCSS, new QTableWidgetItem(empty || !mem.ctcss ? "" : QString::number(mem.ctcss / 10.0, 'f', 1)));
+        ui->tableWidget->setItem(row, MEM_COL_NAME, new QTableWidgetItem(mem.name));
+    }
+}
+
+//* Channel from the table row, as edited by the user
+rigChannel DialogMemory::tableChannel(int row)
+{
+    rigChannel mem = {};
+    mem.num = ui->tableWidget->verticalHeaderItem(row)->text().toInt();
+    mem.freq = ui->tableWidget->item(row, MEM_COL_FREQ)->text().toDouble();
+    mem.mode = rig_parse_mode(ui->tableWidget->item(row, MEM_COL_MODE)->text().toLatin1());
+    mem.width = ui->tableWidget->item(row, MEM_COL_WIDTH)->text().toInt();
+    mem.txFreq = ui->tableWidget->item(row, MEM_COL_TXFREQ)->text().toDouble();
+    mem.split = mem.txFreq ? RIG_SPLIT_ON : RIG_SPLIT_OFF;
+    mem.rptrShift = rig_parse_rptr_shift(ui->tableWidget->item(row, MEM_COL_SHIFT)->text().toLatin1());
+    mem.rptrOffs = ui->tableWidget->item(row, MEM_COL_OFFSET)->text().toInt();
+    mem.ctcss = qRound(ui->tableWidget->item(row, MEM_COL_CTCSS)->text().toDouble() * 10);
+    mem.name = ui->tableWidget->item(row, MEM_COL_NAME)->text();
+
+    if (mem.freq == 0)  //Empty row, clear the channel
+    {
+        int num = mem.num;
+        mem = {};
+        mem.num = num;
+    }
+    return mem;
+}
+
+void DialogMemory::setBusy(int state)
+{
+    busy = state;
+    ui->pushButton_Read->setEnabled(!busy && !cache.isEmpty());
+    ui->pushButton_Write->setEnabled(!busy && !cache.isEmpty());
+    ui->pushButton_Cancel->setEnabled(busy);
+    ui->tableWidget->setEnabled(!busy);
+    if (!busy) ui->progressBar->setValue(0);
+}
+
+
+void DialogMemory::on_pushButton_Read_clicked()
+{
+    ui->progressBar->setMaximum(cache.size());
+    ui->label_status->setText("Reading...");
+    setBusy(1);
+
+    emit memoryRead(cache.keys(), memoryBuffer);
+}
+
+//* Write back only the channels changed against the cache
+void DialogMemory::on_pushButton_Write_clicked()
+{
+    pending.clear();
+    for (int row = 0; row < ui->tableWidget->rowCount(); row++)
+    {
+        rigChannel mem = tableChannel(row);
+        if (!sameChannel(mem, cache.value(mem.num))) pending.append(mem);
+    }
+
+    if (pending.isEmpty())
+    {
+        ui->label_status->setText("No changes");
+        return;
+    }
+
+    ui->progressBar->setMaximum(pending.size());
+    ui->label_status->setText(QString("Writing %1 channels...").arg(pending.size()));
+    setBusy(2);
+
+    emit memoryWrite(pending);
+}
+
+void DialogMemory::on_pushButton_Cancel_clicked()
+{
+    emit memoryStop();
+}
+
+void DialogMemory::reject()
+{
+    if (busy) emit memoryStop();    //Keep open until the daemon is done
+    else QDialog::reject();
+}
+
+
+void DialogMemory::on_memoryProgress(int done, int total)
+{
+    ui->progressBar->setMaximum(total);
+    ui->progressBar->setValue(done);
+}
+
+void DialogMemory::on_memoryDone(int count, int retcode)
+{
+    if (busy == 1)
+    {
+        int failed = 0;
+        for (int i = 0; i < memoryBuffer->size(); i++)
+        {
+            if (memoryBuffer->at(i).error == RIG_OK) cache.insert(memoryBuffer->at(i).num, memoryBuffer->at(i));    //Blank channels included
+            else failed++;  //Link error, keep the cached content
+        }
+        ui->label_status->setText(QString("%1 of %2 channels read").arg(count - failed).arg(cache.size()));
+        if (failed) ui->label_status->setText(ui->label_status->text() + QString(", %1 failed").arg(failed));
+    }
+    else if (busy == 2)
+    {
+        for (int i = 0; i < count && i < pending.size(); i++) cache.insert(pending.at(i).num, pending.at(i));
+        ui->label_status->setText(QString("%1 of %2 channels written").arg(count).arg(pending.size()));
+    }
+    else return;
+
+    if (retcode != RIG_OK) ui->label_status->setText(ui->label_status->text() + QString(", ") + rigerror(retcode));
+
+    saveCache();
+    setTable();
+    setBusy(0);
+}
@@ -0,0 +1,73 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DIALOGMEMORY_H
+#define DIALOGMEMORY_H
+
+#include <QDialog>
+#include <QMap>
+
+#include "rig.h"
+#include "rigdata.h"
+
+
+namespace Ui {
+class DialogMemory;
+}
+
+class DialogMemory : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogMemory(RIG *rig, QList<rigChannel> *buffer, QWidget *parent = nullptr);
+    ~DialogMemory();
+
+public slots:
+    void on_memoryProgress(int done, int total);
+    void on_memoryDone(int count, int retcode);
+    void reject() override;
+
+signals:
+    void memoryRead(QList<int> channels, QList<rigChannel> *result);
+    void memoryWrite(QList<rigChannel> channels);
+    void memoryStop();
+
+private slots:
+    void on_pushButton_Read_clicked();
+    void on_pushButton_Write_clicked();
+    void on_pushButton_Cancel_clicked();
+
+private:
+    Ui::DialogMemory *ui;
+    RIG *my_rig;
+    QList<rigChannel> *memoryBuffer;    //Read buffer, filled by RigDaemon::memoryRead
+    QMap<int, rigChannel> cache;    //Last known rig content, by channel number
+    QList<rigChannel> pending;  //Channels being written
+    int busy;   //0 = idle, 1 = reading, 2 = writing
+
+    QString cacheFileName();
+    void loadCache();
+    void saveCache();
+    void setTable();
+    rigChannel tableChannel(int row);
+    void setBusy(int state);
+};
+
+#endif // DIALOGMEMORY_H
@@ -0,0 +1,129 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "dialogrotator.h"
+#include "ui_dialogrotator.h"
+
+#include <QSettings>
+#include <QSignalBlocker>
+
+#include "rigdata.h"
+#include "rotdaemon.h"
+
+
+extern rotConnection rotCom;
+
+
+DialogRotator::DialogRotator(RotDaemon *rotDaemonPtr, QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::DialogRotator)
+    , rotDaemon(rotDaemonPtr)
+{
+    ui->setupUi(this);
+
+    ui->spinBox_rotModel->setValue(rotCom.rotModel);
+    ui->lineEdit_rotPort->setText(rotCom.rotPort);
+
+    connect(rotDaemon, &RotDaemon::connected, this, &DialogRotator::on_rotConnected);
+    connect(rotDaemon, &RotDaemon::positionUpdated, this, &DialogRotator::on_rotPositionUpdated);
+    connect(ui->widget_compass, &Compass::azimuthClicked, this, &DialogRotator::on_compassAzimuthClicked);
+}
+
+DialogRotator::~DialogRotator()
+{
+    delete ui;
+}
+
+
+void DialogRotator::on_rotConnected(int retcode, QString name)
+{
+    const QSignalBlocker blocker(ui->pushButton_Connect);
+
+    if (retcode != RIG_OK)
+    {
+        ui->pushButton_Connect->setChecked(false);
+        ui->label_status->setText(QString("Connection error: ") + rigerror(retcode));
+    }
+    else
+    {
+        ui->pushButton_Connect->setChecked(true);
+        ui->label_status->setText("Connected to " + name);
+    }
+}
+
+
+void DialogRotator::on_rotPositionUpdated(double azimuth, double elevation, bool moving)
+{
+    ui->widget_compass->setAzimuth(azimuth);
+    ui->widget_compass->setMoving(moving);
+    ui->label_position->setText(QString("Az %1°  El %2°").arg(azimuth, 0, 'f', 1).arg(elevation, 0, 'f', 1));
+}
+
+
+void DialogRotator::on_compassAzimuthClicked(double azimuth)
+{
+    ui->doubleSpinBox_azimuth->setValue(azimuth);
+}
+
+
+void DialogRotator::on_pushButton_Connect_toggled(bool checked)
+{
+    if (checked)
+    {
+        rotCom.rotModel = ui->spinBox_rotModel->value();
+        rotCom.rotPort = ui->lineEdit_rotPort->text();
+
+        //* Save settings in catradio.ini
+        QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+        configFile.setValue("Rotator/rotModel", rotCom.rotModel);
+        configFile.setValue("Rotator/rotPort", rotCom.rotPort);
+
+        rotConnection conf = rotCom;
+        RotDaemon *daemon = rotDaemon;
+        QMetaObject::invokeMethod(rotDaemon, [daemon, conf]()
+        {
+            daemon->rotConnect(conf.rotModel, conf.rotPort, conf.serialSpeed, conf.pollFast, conf.pollSlow);
+        }, Qt::QueuedConnection);
+    }
+    else
+    {
+        RotDaemon *daemon = rotDaemon;
+        QMetaObject::invokeMethod(rotDaemon, [daemon](){ daemon->rotDisconnect(); }, Qt::QueuedConnection);
+        ui->label_status->setText("Disconnected");
+    }
+}
+
+
+void DialogRotator::on_pushButton_GoTo_clicked()
+{
+    double az = ui->doubleSpinBox_azimuth->value();
+    double el = ui->doubleSpinBox_elevation->value();
+
+    ui->widget_compass->setTarget(az);
+
+    RotDaemon *daemon = rotDaemon;
+    QMetaObject::invokeMethod(rotDaemon, [daemon, az, el](){ daemon->setPosition(az, el); }, Qt::QueuedConnection);
+}
+
+
+void DialogRotator::on_pushButton_Stop_clicked()
+{
+    RotDaemon *daemon = rotDaemon;
+    QMetaObject::invokeMethod(rotDaemon, [daemon](){ daemon->stop(); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,54 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DIALOGROTATOR_H
+#define DIALOGROTATOR_H
+
+#include <QDialog>
+
+class RotDaemon;
+
+
+namespace Ui {
+class DialogRotator;
+}
+
+class DialogRotator : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogRotator(RotDaemon *rotDaemonPtr = nullptr, QWidget *parent = nullptr);
+    ~DialogRotator();
+
+private slots:
+    void on_rotConnected(int retcode, QString name);
+    void on_rotPositionUpdated(double azimuth, double elevation, bool moving);
+    void on_compassAzimuthClicked(double azimuth);
+
+    void on_pushButton_Connect_toggled(bool checked);
+    void on_pushButton_GoTo_clicked();
+    void on_pushButton_Stop_clicked();
+
+private:
+    Ui::DialogRotator *ui;
+    RotDaemon *rotDaemon;
+};
+
+#endif // DIALOGROTATOR_H
@@ -42,6 +42,7 @@ DialogSetup::DialogSetup(QWidget *parent) :
    if (guiConf.voiceKeyerMode == 1) ui->radioButton_voiceKeyerMode_CatRadio->setChecked(true);
    if (guiConf.peakHold) ui->checkBox_peakHold->setChecked(true);
    if (guiConf.debugMode) ui->checkBox_debug->setChecked(true);
+   if (guiConf.debugBinary) ui->checkBox_debugBinary->setChecked(true);
 }
 
 DialogSetup::~DialogSetup()
@@ -67,6 +68,7 @@ void DialogSetup::on_buttonBox_accepted()
     guiConf.voiceKeyerMode = ui->radioButton_voiceKeyerMode_CatRadio->isChecked();
     guiConf.peakHold = ui->checkBox_peakHold->isChecked();
     guiConf.debugMode = ui->checkBox_debug->isChecked();
+    guiConf.debugBinary = ui->checkBox_debugBinary->isChecked();
 
     //* Save settings in catradio.ini
     QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
@@ -76,4 +78,5 @@ void DialogSetup::on_buttonBox_accepted()
     configFile.setValue("voiceKeyerMode", guiConf.voiceKeyerMode);
     configFile.setValue("peakHold", guiConf.peakHold);
     configFile.setValue("debugMode", guiConf.debugMode);
+    configFile.setValue("debugBinary", guiConf.debugBinary);
 }
@@ -0,0 +1,166 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "dialogstats.h"
+#include "ui_dialogstats.h"
+
+#include "rigstats.h"
+
+#include <QPainter>
+#include <QPixmap>
+#include <QDebug>
+
+
+DialogStats::DialogStats(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::DialogStats)
+{
+    ui->setupUi(this);
+
+    ui->tableWidget_Calls->setColumnCount(7);
+    ui->tableWidget_Calls->setHorizontalHeaderLabels({"Call", "Count", "p50 (ms)", "p99 (ms)", "Max (ms)", "Errors", "Timeouts"});
+    ui->tableWidget_Calls->verticalHeader()->setVisible(false);
+
+    wall.start();
+
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &DialogStats::statsUpdate);
+    timer->start(1000);
+
+    statsUpdate();
+}
+
+DialogStats::~DialogStats()
+{
+    timer->stop();
+    delete ui;
+}
+
+void DialogStats::statsUpdate()
+{
+    RigStats *stats = RigStats::active();
+    if (!isVisible() || !stats) return;
+
+    if (stats != shown) //First update, reset or session switched, restart the rates
+    {
+        shown = stats;
+        lastCommands = stats->commands.loadRelaxed();
+        lastBusy = stats->busy.loadRelaxed();
+        wall.restart();
+        ui->tableWidget_Calls->setRowCount(0);
+    }
+
+    //* Rates over the refresh interval
+    double elapsed = wall.restart() / 1000.0;
+    quint64 commands = stats->commands.loadRelaxed();
+    quint64 busy = stats->busy.loadRelaxed();
+
+    if (elapsed > 0)
+    {
+        ui->label_CommandsValue->setText(QString::number((commands - lastCommands) / elapsed, 'f', 1));
+        ui->label_UtilValue->setText(QString::number(qMin(100.0, (busy - lastBusy) / (elapsed * 10000)), 'f', 1) + " %");  //us over s, in %
+    }
+    lastCommands = commands;
+    lastBusy = busy;
+
+    ui->label_QueueValue->setText(QString::number(stats->queueDepth.loadRelaxed()));
+    ui->label_PollValue->setText(QString("p50 %1 ms  p99 %2 ms  max %3 ms  (%4 cycles)")
+                                     .arg(stats->pollTime.percentile(0.5) / 1000.0, 0, 'f', 1)
+                                     .arg(stats->pollTime.percentile(0.99) / 1000.0, 0, 'f', 1)
+                                     .arg(stats->pollTime.max() / 1000.0, 0, 'f', 1)
+                                     .arg(stats->pollTime.count()));
+
+    //* Per call latency, only the calls used so far
+    int row = 0;
+    for (int call = 1; call < TAPE_CALL_MAX; call++)
+    {
+        const StatsHistogram &hist = stats->callTime[call];
+        if (!hist.count()) continue;
+
+        if (row >= ui->tableWidget_Calls->rowCount())
+        {
+            ui->tableWidget_Calls->insertRow(row);
+            for (int col = 0; col < 7; col++) ui->tableWidget_Calls->setItem(row, col, new QTableWidgetItem());
+        }
+
+        ui->tableWidget_Calls->item(row, 0)->setText(tape_call_name(call));
+        ui->tableWidget_Calls->item(row, 1)->setText(QString::number(hist.count()));
+        ui->tableWidget_Calls->item(row, 2)->setText(QString::number(hist.percentile(0.5) / 1000.0, 'f', 1));
+        ui->tableWidget_Calls->item(row, 3)->setText(QString::number(hist.percentile(0.99) / 1000.0, 'f', 1));
+        ui->tableWidget_Calls->item(row, 4)->setText(QString::number(hist.max() / 1000.0, 'f', 1));
+        ui->tableWidget_Calls->item(row, 5)->setText(QString::number(stats->errors[call].loadRelaxed()));
+        ui->tableWidget_Calls->item(row, 6)->setText(QString::number(stats->timeouts[call].loadRelaxed()));
+        row++;
+    }
+    ui->tableWidget_Calls->setRowCount(row);
+
+    drawPollHistogram(stats);
+}
+
+//* Poll cycle histogram, one bar per bucket from the first to the last used
+void DialogStats::drawPollHistogram(const RigStats *stats)
+{
+    QSize size = ui->label_PollHistogram->size();
+    QPixmap pixmap(size);
+    pixmap.fill(palette().color(QPalette::Base));
+
+    const StatsHistogram &hist = stats->pollTime;
+    int first = STATS_BUCKETS, last = -1;
+    quint32 peak = 0;
+    for (int i = 0; i < STATS_BUCKETS; i++)
+    {
+        quint32 value = hist.bucket(i);
+        if (!value) continue;
+        first = qMin(first, i);
+        last = i;
+        peak = qMax(peak, value);
+    }
+
+    QPainter painter(&pixmap);
+    painter.setPen(palette().color(QPalette::Text));
+
+    if (last >= 0)
+    {
+        int bars = last - first + 1;
+        double width = double(size.width()) / bars;
+        int height = size.height() - painter.fontMetrics().height();
+
+        for (int i = first; i <= last; i++)
+        {
+            int h = qRound(double(hist.bucket(i)) * height / peak);
+            painter.fillRect(QRectF((i - first) * width, height - h, qMax(1.0, width - 1), h), palette().color(QPalette::Highlight));
+        }
+
+        painter.drawText(QRect(0, height, size.width(), size.height() - height), Qt::AlignLeft, QString::number(StatsHistogram::bucketValue(first) / 1000.0, 'f', 1) + " ms");
+        painter.drawText(QRect(0, height, size.width(), size.height() - height), Qt::AlignRight, QString::number(StatsHistogram::bucketValue(last) / 1000.0, 'f', 1) + " ms");
+    }
+    else painter.drawText(pixmap.rect(), Qt::AlignCenter, "No data");
+
+    painter.end();
+    ui->label_PollHistogram->setPixmap(pixmap);
+}
+
+void DialogStats::on_pushButton_Reset_clicked()
+{
+    qInfo() << "Link statistics reset";
+    if (RigStats *stats = RigStats::active()) stats->reset();
+    shown = nullptr;    //Restart the rates from the reset counters
+    ui->tableWidget_Calls->setRowCount(0);
+    statsUpdate();
+}
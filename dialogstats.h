@@ -0,0 +1,58 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DIALOGSTATS_H
+#define DIALOGSTATS_H
+
+#include <QDialog>
+#include <QTimer>
+#include <QElapsedTimer>
+
+
+class RigStats;
+
+namespace Ui {
+class DialogStats;
+}
+
+class DialogStats : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogStats(QWidget *parent = nullptr);
+    ~DialogStats();
+
+private slots:
+    void statsUpdate(); //Slot for refresh timer
+    void on_pushButton_Reset_clicked();
+
+private:
+    Ui::DialogStats *ui;
+    QTimer *timer;
+
+    QElapsedTimer wall;
+    RigStats *shown = nullptr;  //Stats on display, the active session
+    quint64 lastCommands;
+    quint64 lastBusy;
+
+    void drawPollHistogram(const RigStats *stats);
+};
+
+#endif // DIALOGSTATS_H
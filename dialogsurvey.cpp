@@ -0,0 +1,122 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "dialogsurvey.h"
+#include "ui_dialogsurvey.h"
+
+#include <QSettings>
+#include <QSignalBlocker>
+
+#include "survey.h"
+
+
+DialogSurvey::DialogSurvey(SurveyFile *surveyPtr, QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::DialogSurvey)
+    , survey(surveyPtr)
+{
+    ui->setupUi(this);
+
+    QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+    ui->doubleSpinBox_start->setValue(configFile.value("Survey/start", 14000).toDouble());  //kHz
+    ui->doubleSpinBox_stop->setValue(configFile.value("Survey/stop", 14350).toDouble());
+    ui->spinBox_step->setValue(configFile.value("Survey/step", 1000).toInt());  //Hz
+    ui->spinBox_interval->setValue(configFile.value("Survey/interval", 60).toInt());  //s
+    ui->spinBox_rows->setValue(configFile.value("Survey/rows", 10080).toInt());
+    ui->lineEdit_file->setText(configFile.value("Survey/file", "survey.dat").toString());
+
+    ui->widget_heatmap->setSurvey(survey);
+    ui->verticalScrollBar->setRange(0, 0);
+}
+
+DialogSurvey::~DialogSurvey()
+{
+    delete ui;
+}
+
+
+void DialogSurvey::on_surveyRow(quint64 count, qint64 sweepTime)
+{
+    int history = qMin<quint64>(count, survey->rows() - 1);   //The oldest slot is being overwritten
+    ui->verticalScrollBar->setMaximum(history);
+
+    if (ui->verticalScrollBar->value() == 0) ui->widget_heatmap->rowAppended();   //Following the newest row
+    else ui->verticalScrollBar->setValue(ui->verticalScrollBar->value() + 1);   //Keep the same rows on screen
+
+    ui->label_status->setText(QString("%1 rows, sweep %2 ms").arg(count).arg(sweepTime));
+}
+
+
+void DialogSurvey::on_surveyFinished()
+{
+    const QSignalBlocker blocker(ui->pushButton_Start);
+    ui->pushButton_Start->setChecked(false);
+    ui->groupBox_setup->setEnabled(true);
+}
+
+
+void DialogSurvey::on_pushButton_Start_toggled(bool checked)
+{
+    if (!checked)
+    {
+        emit surveyStop();
+        return;
+    }
+
+    scanConfig scan;
+    scan.start = ui->doubleSpinBox_start->value() * 1000;
+    scan.stop = ui->doubleSpinBox_stop->value() * 1000;
+    scan.step = ui->spinBox_step->value();
+    scan.threshold = 127;   //No squelch
+    scan.hang = 0;
+    scan.dwell = 5;
+    scan.dwellMax = 5;
+
+    int bins = (scan.stop - scan.start) / scan.step + 1;
+
+    //* Save settings in catradio.ini
+    QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+    configFile.setValue("Survey/start", ui->doubleSpinBox_start->value());
+    configFile.setValue("Survey/stop", ui->doubleSpinBox_stop->value());
+    configFile.setValue("Survey/step", ui->spinBox_step->value());
+    configFile.setValue("Survey/interval", ui->spinBox_interval->value());
+    configFile.setValue("Survey/rows", ui->spinBox_rows->value());
+    configFile.setValue("Survey/file", ui->lineEdit_file->text());
+    scan.dwell = configFile.value("Survey/dwell", 5).toInt();
+
+    if (bins <= 0 || !survey->open(ui->lineEdit_file->text(), scan.start, scan.step, bins, ui->spinBox_rows->value()))
+    {
+        ui->label_status->setText("Unable to open the survey file");
+        on_surveyFinished();
+        return;
+    }
+
+    ui->widget_heatmap->setSurvey(survey);
+    ui->verticalScrollBar->setMaximum(qMin<quint64>(survey->count(), survey->rows() - 1));
+    ui->verticalScrollBar->setValue(0);
+    ui->groupBox_setup->setEnabled(false);
+
+    emit surveyStart(scan, ui->spinBox_interval->value());
+}
+
+
+void DialogSurvey::on_verticalScrollBar_valueChanged(int value)
+{
+    ui->widget_heatmap->setOffset(value);
+}
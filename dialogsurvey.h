@@ -0,0 +1,59 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DIALOGSURVEY_H
+#define DIALOGSURVEY_H
+
+#include <QDialog>
+
+#include "rigdata.h"
+
+class SurveyFile;
+
+
+namespace Ui {
+class DialogSurvey;
+}
+
+class DialogSurvey : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DialogSurvey(SurveyFile *surveyPtr = nullptr, QWidget *parent = nullptr);
+    ~DialogSurvey();
+
+public slots:
+    void on_surveyRow(quint64 count, qint64 sweepTime);
+    void on_surveyFinished();
+
+signals:
+    void surveyStart(scanConfig scan, int interval);
+    void surveyStop();
+
+private slots:
+    void on_pushButton_Start_toggled(bool checked);
+    void on_verticalScrollBar_valueChanged(int value);
+
+private:
+    Ui::DialogSurvey *ui;
+    SurveyFile *survey;
+};
+
+#endif // DIALOGSURVEY_H
@@ -0,0 +1,360 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "doppler.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+
+#include <cmath>
+
+//WGS-72 constants as used by SGP4 (Spacetrack Report #3)
+#define XKMPER 6378.135     //Earth equatorial radius (km)
+#define XKE 0.0743669161    //sqrt(GM) (er^1.5/min)
+#define CK2 5.413080e-4     //J2/2
+#define CK4 6.209887e-7     //-3*J4/8
+#define XJ3 -2.53881e-6     //J3
+#define QOMS2T 1.880279e-09 //((120 - 78)/XKMPER)^4
+#define S_DENS 1.012229     //78 km/XKMPER + 1
+#define FLATTENING (1.0/298.26)
+#define OMEGA_E 7.292115e-5 //Earth rotation (rad/s)
+#define C_LIGHT 299792.458  //Speed of light (km/s)
+#define TWOPI (2.0*M_PI)
+#define DEG2RAD (M_PI/180.0)
+
+
+Doppler::Doppler()
+{
+    isLoaded = false;
+    setQth(0, 0, 0);
+}
+
+//* Load satellite elements from a TLE file
+//* The file contains name, line 1 and line 2 for each satellite (Celestrak format)
+bool Doppler::loadTle(QString tleFileName, QString satName)
+{
+    isLoaded = false;
+
+    QFile tleFile(tleFileName);
+    if (!tleFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "TLE file not found" << tleFileName;
+        return false;
+    }
+
+    QTextStream in(&tleFile);
+    QString name, line1, line2;
+    bool found = false;
+
+    while (!in.atEnd() && !found)
+    {
+        QString line = in.readLine();
+        if (line.trimmed().compare(satName.trimmed(), Qt::CaseInsensitive) == 0)
+        {
+            name = line.trimmed();
+            line1 = in.readLine();
+            line2 = in.readLine();
+            found = line1.startsWith("1 ") && line2.startsWith("2 ") && line1.length() >= 63 && line2.length() >= 63;
+        }
+    }
+    tleFile.close();
+
+    if (!found)
+    {
+        qWarning() << "Satellite not found in TLE file" << satName;
+        return false;
+    }
+
+    //Line 1
+    int year = line1.mid(18, 2).toInt();
+    year += (year < 57) ? 2000 : 1900;
+    double epochDay = line1.mid(20, 12).toDouble();
+    bstar = ("0." + line1.mid(54, 5)).toDouble() * pow(10.0, line1.mid(59, 2).toInt());   //Implied decimal point, e.g. 12345-3 = 0.12345e-3
+    if (line1.at(53) == '-') bstar = -bstar;
+
+    //Line 2
+    xincl = line2.mid(8, 8).toDouble() * DEG2RAD;
+    xnodeo = line2.mid(17, 8).toDouble() * DEG2RAD;
+    eo = ("0." + line2.mid(26, 7).trimmed()).toDouble();
+    omegao = line2.mid(34, 8).toDouble() * DEG2RAD;
+    xmo = line2.mid(43, 8).toDouble() * DEG2RAD;
+    xno = line2.mid(52, 11).toDouble() * TWOPI / 1440.0;   //rev/day to rad/min
+
+    if (xno <= 0) return false;
+    if (TWOPI / xno >= 225.0)   //Deep space orbit, SDP4 not implemented
+    {
+        qWarning() << "Deep space satellite not supported" << name;
+        return false;
+    }
+
+    //Epoch Julian date
+    int y = year - 1;
+    epochJd = 1721424.5 + 365.0 * y + y / 4 - y / 100 + y / 400 + epochDay;
+
+    this->satName = name;
+    sgp4Init();
+    isLoaded = true;
+
+    qInfo() << "TLE loaded" << name;
+
+    return true;
+}
+
+void Doppler::setQth(double latitude, double longitude, double altitude)
+{
+    qthLat = latitude * DEG2RAD;
+    qthLon = longitude * DEG2RAD;
+    qthAlt = altitude / 1000.0;
+}
+
+//* SGP4 initialization, near earth only
+void Doppler::sgp4Init()
+{
+    //Recover original mean motion and semimajor axis from the input elements
+    double a1 = pow(XKE / xno, 2.0 / 3.0);
+    cosio = cos(xincl);
+    sinio = sin(xincl);
+    double theta2 = cosio * cosio;
+    x3thm1 = 3.0 * theta2 - 1.0;
+    double eosq = eo * eo;
+    double betao2 = 1.0 - eosq;
+    double betao = sqrt(betao2);
+    double del1 = 1.5 * CK2 * x3thm1 / (a1 * a1 * betao * betao2);
+    double ao = a1 * (1.0 - del1 * (1.0 / 3.0 + del1 * (1.0 + 134.0 / 81.0 * del1)));
+    double delo = 1.5 * CK2 * x3thm1 / (ao * ao * betao * betao2);
+    xnodp = xno / (1.0 + delo);
+    aodp = ao / (1.0 - delo);
+
+    //Perigee below 220 km uses the simplified equations
+    isimp = (aodp * (1.0 - eo)) < (220.0 / XKMPER + 1.0);
+
+    //Atmospheric density parameters for low perigee
+    double s4 = S_DENS;
+    double qoms24 = QOMS2T;
+    double perige = (aodp * (1.0 - eo) - 1.0) * XKMPER;
+    if (perige < 156.0)
+    {
+        s4 = (perige <= 98.0) ? 20.0 : perige - 78.0;
+        qoms24 = pow((120.0 - s4) / XKMPER, 4.0);
+        s4 = s4 / XKMPER + 1.0;
+    }
+
+    double pinvsq = 1.0 / (aodp * aodp * betao2 * betao2);
+    double tsi = 1.0 / (aodp - s4);
+    eta = aodp * eo * tsi;
+    double etasq = eta * eta;
+    double eeta = eo * eta;
+    double psisq = fabs(1.0 - etasq);
+    double coef = qoms24 * pow(tsi, 4.0);
+    double coef1 = coef / pow(psisq, 3.5);
+    double c2 = coef1 * xnodp * (aodp * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) + 0.75 * CK2 * tsi / psisq * x3thm1 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    c1 = bstar * c2;
+    double a3ovk2 = -XJ3 / CK2;
+    double c3 = (eo > 1.0e-4) ? coef * tsi * a3ovk2 * xnodp * sinio / eo : 0.0;
+    x1mth2 = 1.0 - theta2;
+    c4 = 2.0 * xnodp * coef1 * aodp * betao2 * (eta * (2.0 + 0.5 * etasq) + eo * (0.5 + 2.0 * etasq) - 2.0 * CK2 * tsi / (aodp * psisq) * (-3.0 * x3thm1 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) + 0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * cos(2.0 * omegao)));
+    c5 = 2.0 * coef1 * aodp * betao2 * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+    //Secular rates
+    double theta4 = theta2 * theta2;
+    double temp1 = 3.0 * CK2 * pinvsq * xnodp;
+    double temp2 = temp1 * CK2 * pinvsq;
+    double temp3 = 1.25 * CK4 * pinvsq * pinvsq * xnodp;
+    xmdot = xnodp + 0.5 * temp1 * betao * x3thm1 + 0.0625 * temp2 * betao * (13.0 - 78.0 * theta2 + 137.0 * theta4);
+    double x1m5th = 1.0 - 5.0 * theta2;
+    omgdot = -0.5 * temp1 * x1m5th + 0.0625 * temp2 * (7.0 - 114.0 * theta2 + 395.0 * theta4) + temp3 * (3.0 - 36.0 * theta2 + 49.0 * theta4);
+    double xhdot1 = -temp1 * cosio;
+    xnodot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * theta2) + 2.0 * temp3 * (3.0 - 7.0 * theta2)) * cosio;
+    omgcof = bstar * c3 * cos(omegao);
+    xmcof = (eo > 1.0e-4) ? -2.0 / 3.0 * coef * bstar / eeta : 0.0;
+    xnodcf = 3.5 * betao2 * xhdot1 * c1;
+    t2cof = 1.5 * c1;
+    xlcof = 0.125 * a3ovk2 * sinio * (3.0 + 5.0 * cosio) / (1.0 + cosio);
+    aycof = 0.25 * a3ovk2 * sinio;
+    delmo = pow(1.0 + eta * cos(xmo), 3.0);
+    sinmo = sin(xmo);
+    x7thm1 = 7.0 * theta2 - 1.0;
+
+    d2 = d3 = d4 = t3cof = t4cof = t5cof = 0;
+    if (!isimp)
+    {
+        double c1sq = c1 * c1;
+        d2 = 4.0 * aodp * tsi * c1sq;
+        double temp = d2 * tsi * c1 / 3.0;
+        d3 = (17.0 * aodp + s4) * temp;
+        d4 = 0.5 * temp * aodp * tsi * (221.0 * aodp + 31.0 * s4) * c1;
+        t3cof = d2 + 2.0 * c1sq;
+        t4cof = 0.25 * (3.0 * d3 + c1 * (12.0 * d2 + 10.0 * c1sq));
+        t5cof = 0.2 * (3.0 * d4 + 12.0 * c1 * d3 + 6.0 * d2 * d2 + 15.0 * c1sq * (2.0 * d2 + c1sq));
+    }
+}
+
+//* SGP4 propagation, tsince in minutes from epoch
+void Doppler::sgp4(double tsince, double pos[3], double vel[3])
+{
+    //Secular gravity and atmospheric drag
+    double xmdf = xmo + xmdot * tsince;
+    double omgadf = omegao + omgdot * tsince;
+    double xnoddf = xnodeo + xnodot * tsince;
+    double omega = omgadf;
+    double xmp = xmdf;
+    double tsq = tsince * tsince;
+    double xnode = xnoddf + xnodcf * tsq;
+    double tempa = 1.0 - c1 * tsince;
+    double tempe = bstar * c4 * tsince;
+    double templ = t2cof * tsq;
+
+    if (!isimp)
+    {
+        double delomg = omgcof * tsince;
+        double delm = xmcof * (pow(1.0 + eta * cos(xmdf), 3.0) - delmo);
+        double temp = delomg + delm;
+        xmp = xmdf + temp;
+        omega = omgadf - temp;
+        double tcube = tsq * tsince;
+        double tfour = tsince * tcube;
+        tempa = tempa - d2 * tsq - d3 * tcube - d4 * tfour;
+        tempe = tempe + bstar * c5 * (sin(xmp) - sinmo);
+        templ = templ + t3cof * tcube + tfour * (t4cof + tsince * t5cof);
+    }
+
+    double a = aodp * tempa * tempa;
+    double e = eo - tempe;
+    if (e < 1.0e-6) e = 1.0e-6;
+    double xl = xmp + omega + xnode + xnodp * templ;
+    double beta = sqrt(1.0 - e * e);
+    double xn = XKE / pow(a, 1.5);
+
+    //Long period periodics
+    double axn = e * cos(omega);
+    double temp = 1.0 / (a * beta * beta);
+    double xll = temp * xlcof * axn;
+    double aynl = temp * aycof;
+    double xlt = xl + xll;
+    double ayn = e * sin(omega) + aynl;
+
+    //Solve Kepler's equation
+    double capu = fmod(xlt - xnode, TWOPI);
+    double epw = capu;
+    double sinepw = 0, cosepw = 0, temp3 = 0, temp4 = 0, temp5 = 0, temp6 = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        sinepw = sin(epw);
+        cosepw = cos(epw);
+        temp3 = axn * sinepw;
+        temp4 = ayn * cosepw;
+        temp5 = axn * cosepw;
+        temp6 = ayn * sinepw;
+        double next = (capu - temp4 + temp3 - epw) / (1.0 - temp5 - temp6) + epw;
+        if (fabs(next - epw) <= 1.0e-12) break;
+        epw = next;
+    }
+
+    //Short period preliminary quantities
+    double ecose = temp5 + temp6;
+    double esine = temp3 - temp4;
+    double elsq = axn * axn + ayn * ayn;
+    temp = 1.0 - elsq;
+    double pl = a * temp;
+    double r = a * (1.0 - ecose);
+    double temp1 = 1.0 / r;
+    double rdot = XKE * sqrt(a) * esine * temp1;
+    double rfdot = XKE * sqrt(pl) * temp1;
+    double temp2 = a * temp1;
+    double betal = sqrt(temp);
+    temp3 = 1.0 / (1.0 + betal);
+    double cosu = temp2 * (cosepw - axn + ayn * esine * temp3);
+    double sinu = temp2 * (sinepw - ayn - axn * esine * temp3);
+    double u = atan2(sinu, cosu);
+    double sin2u = 2.0 * sinu * cosu;
+    double cos2u = 2.0 * cosu * cosu - 1.0;
+    temp = 1.0 / pl;
+    temp1 = CK2 * temp;
+    temp2 = temp1 * temp;
+
+    //Short periodics
+    double rk = r * (1.0 - 1.5 * temp2 * betal * x3thm1) + 0.5 * temp1 * x1mth2 * cos2u;
+    double uk = u - 0.25 * temp2 * x7thm1 * sin2u;
+    double xnodek = xnode + 1.5 * temp2 * cosio * sin2u;
+    double xinck = xincl + 1.5 * temp2 * cosio * sinio * cos2u;
+    double rdotk = rdot - xn * temp1 * x1mth2 * sin2u;
+    double rfdotk = rfdot + xn * temp1 * (x1mth2 * cos2u + 1.5 * x3thm1);
+
+    //Orientation vectors
+    double sinuk = sin(uk), cosuk = cos(uk);
+    double sinik = sin(xinck), cosik = cos(xinck);
+    double sinnok = sin(xnodek), cosnok = cos(xnodek);
+    double xmx = -sinnok * cosik;
+    double xmy = cosnok * cosik;
+    double ux = xmx * sinuk + cosnok * cosuk;
+    double uy = xmy * sinuk + sinnok * cosuk;
+    double uz = sinik * sinuk;
+    double vx = xmx * cosuk - cosnok * sinuk;
+    double vy = xmy * cosuk - sinnok * sinuk;
+    double vz = sinik * cosuk;
+
+    pos[0] = rk * ux * XKMPER;
+    pos[1] = rk * uy * XKMPER;
+    pos[2] = rk * uz * XKMPER;
+    vel[0] = (rdotk * ux + rfdotk * vx) * XKMPER / 60.0;
+    vel[1] = (rdotk * uy + rfdotk * vy) * XKMPER / 60.0;
+    vel[2] = (rdotk * uz + rfdotk * vz) * XKMPER / 60.0;
+}
+
+//* Range rate (km/s, positive when receding) and elevation (deg) from the QTH at the given UTC time
+bool Doppler::compute(qint64 msecsSinceEpoch, double *rangeRate, double *elevation)
+{
+    if (!isLoaded) return false;
+
+    double jd = msecsSinceEpoch / 86400000.0 + 2440587.5;
+    double tsince = (jd - epochJd) * 1440.0;
+
+    double pos[3], vel[3];
+    sgp4(tsince, pos, vel);
+
+    //Greenwich mean sidereal time
+    double t = (jd - 2451545.0) / 36525.0;
+    double gmst = fmod((67310.54841 + (876600.0 * 3600.0 + 8640184.812866) * t + 0.093104 * t * t - 6.2e-6 * t * t * t) * TWOPI / 86400.0, TWOPI);
+    if (gmst < 0) gmst += TWOPI;
+
+    //Observer position and velocity in the same inertial frame
+    double theta = gmst + qthLon;
+    double sinlat = sin(qthLat), coslat = cos(qthLat);
+    double c = 1.0 / sqrt(1.0 + FLATTENING * (FLATTENING - 2.0) * sinlat * sinlat);
+    double sq = (1.0 - FLATTENING) * (1.0 - FLATTENING) * c;
+    double achcp = (XKMPER * c + qthAlt) * coslat;
+    double obs[3] = {achcp * cos(theta), achcp * sin(theta), (XKMPER * sq + qthAlt) * sinlat};
+    double obsVel[3] = {-OMEGA_E * obs[1], OMEGA_E * obs[0], 0};
+
+    double range[3], rangeVel[3];
+    for (int i = 0; i < 3; i++)
+    {
+        range[i] = pos[i] - obs[i];
+        rangeVel[i] = vel[i] - obsVel[i];
+    }
+    double rangeLen = sqrt(range[0] * range[0] + range[1] * range[1] + range[2] * range[2]);
+
+    *rangeRate = (range[0] * rangeVel[0] + range[1] * rangeVel[1] + range[2] * rangeVel[2]) / rangeLen;
+
+    double topZ = coslat * cos(theta) * range[0] + coslat * sin(theta) * range[1] + sinlat * range[2];
+    *elevation = asin(topZ / rangeLen) / DEG2RAD;
+
+    return true;
+}
@@ -0,0 +1,57 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef DOPPLER_H
+#define DOPPLER_H
+
+#include <QString>
+
+
+class Doppler
+{
+public:
+    Doppler();
+
+    bool loadTle(QString tleFileName, QString satName);    //Load satellite elements from a TLE file
+    void setQth(double latitude, double longitude, double altitude);   //Observer position (deg, deg, m)
+    bool compute(qint64 msecsSinceEpoch, double *rangeRate, double *elevation);    //Range rate (km/s) and elevation (deg) at UTC time
+
+    bool isLoaded;  //Elements loaded flag
+    QString satName;
+
+private:
+    void sgp4Init();
+    void sgp4(double tsince, double pos[3], double vel[3]);    //Near earth SGP4, position (km) and velocity (km/s) TEME
+
+    //Mean elements at epoch
+    double epochJd;     //Epoch Julian date
+    double xmo, xnodeo, omegao, eo, xincl, xno, bstar;
+
+    //SGP4 constants
+    bool isimp;
+    double aodp, xnodp, cosio, sinio, x3thm1, x1mth2, x7thm1;
+    double c1, c4, c5, d2, d3, d4, eta, delmo, sinmo;
+    double xmdot, omgdot, xnodot, omgcof, xmcof, xnodcf;
+    double t2cof, t3cof, t4cof, t5cof, xlcof, aycof;
+
+    //QTH
+    double qthLat, qthLon, qthAlt;
+};
+
+#endif // DOPPLER_H
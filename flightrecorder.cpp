@@ -0,0 +1,165 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "flightrecorder.h"
+#include "rigtape.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QDebug>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+FlightRecorder flightRecorder;
+
+
+FlightRecorder::FlightRecorder()
+{
+    for (quint64 i = 0; i < FLIGHT_LINES; i++) line[i].sequence.storeRelaxed(0);
+    triggerClock.start();
+}
+
+void FlightRecorder::install(FILE *logFile, rig_debug_level_e logLevel)
+{
+    file = logFile;
+    fileLevel = logLevel;
+
+    rig_set_debug_callback(FlightRecorder::callback, this);
+    rig_set_debug_level(RIG_DEBUG_TRACE);
+    qInfo() << "Hamlib flight recorder" << FLIGHT_LINES << "lines";
+}
+
+void FlightRecorder::closeFile()
+{
+    QMutexLocker locker(&fileMutex);    //Waits for a line being written
+    file = nullptr;
+}
+
+//* Called by Hamlib from any thread, each line gets its own slot
+int FlightRecorder::callback(rig_debug_level_e level, rig_ptr_t arg, const char *format, va_list ap)
+{
+    FlightRecorder *recorder = static_cast<FlightRecorder *>(arg);
+
+    va_list copy;
+    va_copy(copy, ap);
+
+    qint64 time = QDateTime::currentMSecsSinceEpoch();
+    quint64 index = recorder->head.fetchAndAddRelaxed(1);
+    flightLine &slot = recorder->line[index & (FLIGHT_LINES - 1)];
+    slot.sequence.storeRelaxed(0);  //Being written
+    std::atomic_thread_fence(std::memory_order_release);    //Visible before any byte of the new entry
+    slot.entry.time = time;
+    slot.entry.level = level;
+    vsnprintf(slot.entry.text, FLIGHT_LINE, format, ap);
+    slot.sequence.storeRelease(index + 1);
+
+    if (level <= recorder->fileLevel)  //Previous hamlib.log content
+    {
+        QMutexLocker locker(&recorder->fileMutex);
+        if (recorder->file)
+        {
+            fprintf(recorder->file, "%s: ", QDateTime::fromMSecsSinceEpoch(time).toString("yyyy-MM-dd hh:mm:ss.zzz").toLatin1().constData());
+            vfprintf(recorder->file, format, copy);
+            fflush(recorder->file);
+        }
+    }
+    va_end(copy);
+
+    return RIG_OK;
+}
+
+//* Snapshot of the ring, formatted and written by a short lived thread
+QString FlightRecorder::dump(QString reason)
+{
+    quint64 last = head.loadAcquire();
+    quint64 first = last > FLIGHT_LINES ? last - FLIGHT_LINES : 0;
+
+    std::vector<flightEntry> snapshot;
+    snapshot.reserve(last - first);
+    for (quint64 i = first; i < last; i++)
+    {
+        const flightLine &slot = line[i & (FLIGHT_LINES - 1)];
+        if (slot.sequence.loadAcquire() != i + 1) continue; //Overwritten or still being written
+        flightEntry entry = slot.entry;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.loadRelaxed() != i + 1) continue; //Overwritten while copying
+        snapshot.push_back(entry);
+    }
+
+    QString fileName = "hamlib-flight-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".log";
+    QString title = QString("CatRadio Hamlib flight recorder, %1, %2\n").arg(reason, QDateTime::currentDateTime().toString(Qt::ISODate));
+
+    std::thread([fileName, title, snapshot]()
+    {
+        static const char *levelName[7] = {"NONE", "BUG", "ERR", "WARN", "VERBOSE", "TRACE", "CACHE"};
+
+        QByteArray text = title.toUtf8();
+        for (const flightEntry &entry : snapshot)
+        {
+            text += QDateTime::fromMSecsSinceEpoch(entry.time).toString("hh:mm:ss.zzz ").toLatin1();
+            text += levelName[entry.level < 7 ? entry.level : 0];
+            text += ' ';
+            text += QByteArray(entry.text, int(qstrnlen(entry.text, FLIGHT_LINE)));
+            if (!text.endsWith('\n')) text += '\n';
+        }
+
+        QFile dumpFile(fileName);
+        if (dumpFile.open(QIODevice::WriteOnly)) dumpFile.write(text);
+    }).detach();
+
+    qInfo() << "Hamlib flight recorder dump" << fileName << reason;
+    return fileName;
+}
+
+void FlightRecorder::trigger(QString reason)
+{
+    qint64 now = triggerClock.elapsed();
+    if (now - lastDump < FLIGHT_HOLDOFF_MS) return;
+    lastDump = now;
+    dump(reason);
+}
+
+void FlightRecorder::result(int call, int retcode)
+{
+    if (head.loadRelaxed() == 0) return;    //Not installed
+
+    if (retcode == -RIG_EIO || retcode == -RIG_EPROTO || retcode == -RIG_EINTERNAL)
+    {
+        QMutexLocker locker(&triggerMutex);
+        linkTrouble = true;
+        trigger(QString("%1 error %2").arg(tape_call_name(call)).arg(rigerror(retcode)).trimmed());
+    }
+    else if (retcode == -RIG_ETIMEOUT)
+    {
+        QMutexLocker locker(&triggerMutex);
+        linkTrouble = true;
+        qint64 now = triggerClock.elapsed();
+        qint64 oldest = timeoutTime[timeoutIndex];  //FLIGHT_STORM timeouts ago
+        timeoutTime[timeoutIndex] = now;
+        timeoutIndex = (timeoutIndex + 1) % FLIGHT_STORM;
+        if (oldest && now - oldest < FLIGHT_STORM_MS) trigger(QString("timeout storm, %1 timeouts in %2 ms").arg(FLIGHT_STORM).arg(now - oldest));
+    }
+    else if (call == TAPE_CALL_OPEN && retcode == RIG_OK)
+    {
+        QMutexLocker locker(&triggerMutex);
+        if (linkTrouble) trigger("reconnect after link errors");
+        linkTrouble = false;
+    }
+}
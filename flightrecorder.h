@@ -0,0 +1,83 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <QString>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <cstdio>
+#include <cstdarg>
+
+#include <rig.h>
+
+#define FLIGHT_LINES 8192   //Ring size, power of 2
+#define FLIGHT_LINE 248     //Max line length
+#define FLIGHT_STORM 5      //Timeouts that trigger a dump...
+#define FLIGHT_STORM_MS 10000   //...within this window
+#define FLIGHT_HOLDOFF_MS 60000 //Min interval between automatic dumps
+
+
+//* Hamlib debug output at trace level kept in memory, dumped to file on error, timeout storm, reconnect or on demand
+class FlightRecorder
+{
+public:
+    FlightRecorder();
+
+    void install(FILE *logFile, rig_debug_level_e logLevel);   //Hamlib callback, lines up to logLevel still go to hamlib.log
+    void closeFile();   //Stop writing hamlib.log before it is closed
+    QString dump(QString reason);   //Returns the file name, written in background
+    void result(int call, int retcode); //Automatic dump triggers, from the Hamlib wrappers
+
+    struct flightEntry
+    {
+        qint64 time;    //ms since epoch
+        quint8 level;
+        char text[FLIGHT_LINE];
+    };
+
+private:
+    struct flightLine
+    {
+        QAtomicInteger<quint64> sequence;
+        flightEntry entry;
+    };
+
+    flightLine line[FLIGHT_LINES];
+    QAtomicInteger<quint64> head = 0;
+    QMutex fileMutex;   //Guards file against closeFile(), the ring stays lock free
+    FILE *file = nullptr;
+    rig_debug_level_e fileLevel = RIG_DEBUG_WARN;
+
+    QMutex triggerMutex;
+    QElapsedTimer triggerClock;
+    qint64 lastDump = -FLIGHT_HOLDOFF_MS;
+    qint64 timeoutTime[FLIGHT_STORM] = {};
+    int timeoutIndex = 0;
+    bool linkTrouble = false;   //Errors or timeouts since the last open
+
+    void trigger(QString reason);
+    static int callback(rig_debug_level_e level, rig_ptr_t arg, const char *format, va_list ap);
+};
+
+extern FlightRecorder flightRecorder;
+
+#endif // FLIGHTRECORDER_H
@@ -23,3 +23,4 @@ guiConfig guiConf;
 guiCommand guiCmd;
 voiceKeyerConfig voiceKConf;
 cwKeyerConfig cwKConf;
+dopplerConfig dopplerConf;
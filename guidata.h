@@ -20,8 +20,6 @@
 #ifndef GUIDATA_H
 #define GUIDATA_H
 
-#endif // GUIDATA_H
-
 #include <QString>
 
 
@@ -38,7 +36,9 @@ typedef struct {
                             //5 AM
     bool darkTheme; //flag for Dark theme
     bool peakHold;  //meters peak hold
+    int meterAttack, meterDecay, meterPeakDecay;    //meters ballistics time constants (ms)
     bool debugMode; //flag for debug log
+    bool debugBinary;   //flag for binary debug log, applied at restart
     int cwKeyerMode;    //0: Radio, 1: WinKeyer
     int voiceKeyerMode; //0: Radio, 1: CatRadio
     int rigModelSort;   //0: Numerically, 1: Alphabetically
@@ -70,3 +70,16 @@ typedef struct {
     int wpm;    //WPM
     bool autoConnect; //Auto-connect flag
 } cwKeyerConfig;
+
+
+typedef struct {
+    QString tleFile;    //TLE file name (3 lines per satellite)
+    QString satName;    //Satellite name as in the TLE file
+    double downlink, uplink;    //Nominal transponder frequencies (Hz)
+    double latitude, longitude; //QTH (deg, East positive)
+    double altitude;    //QTH altitude (m)
+    int rate;   //Update rate (Hz)
+    int step;   //Minimum correction to send (Hz)
+} dopplerConfig;
+
+#endif // GUIDATA_H
@@ -0,0 +1,140 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "heatmap.h"
+#include "survey.h"
+#include <QPainter>
+
+#include <cstring>
+
+#define HEATMAP_LINES 512   //Rows kept in the image
+
+
+Heatmap::Heatmap(QWidget *parent) : QWidget(parent)
+{
+    offset = 0;
+    lastCount = 0;
+    setLevelRange(-54, 30);
+}
+
+void Heatmap::setSurvey(SurveyFile *survey)
+{
+    this->survey = survey;
+    renderAll();
+}
+
+//* Build the 256 entries palette, dark blue (weak) to red (strong)
+void Heatmap::setLevelRange(int min, int max)
+{
+    levelMin = min;
+    levelMax = max > min ? max : min + 1;
+
+    palette.resize(256);
+    for (int i = 0; i < 256; i++)
+    {
+        int level = i - 128;
+        double x = qBound(0.0, double(level - levelMin) / (levelMax - levelMin), 1.0);
+        palette[i] = QColor::fromHsvF((1.0 - x) * 0.66, 1.0, 0.25 + 0.75 * x).rgb();
+    }
+
+    renderAll();
+}
+
+void Heatmap::setOffset(int rows)
+{
+    if (rows == offset) return;
+    offset = rows;
+    renderAll();
+}
+
+//* Only the new row is drawn: the image scrolls up by one line and the row goes at the bottom
+void Heatmap::rowAppended()
+{
+    if (!survey || !survey->isOpen()) return;
+
+    if (offset != 0 || image.width() != survey->bins())
+    {
+        renderAll();
+        return;
+    }
+
+    quint64 count = survey->count();
+    if (count - lastCount >= HEATMAP_LINES)
+    {
+        renderAll();
+        return;
+    }
+
+    int bytesPerLine = image.bytesPerLine();
+    for (; lastCount < count; lastCount++)
+    {
+        memmove(image.bits(), image.bits() + bytesPerLine, bytesPerLine * (HEATMAP_LINES - 1));
+        renderRow(HEATMAP_LINES - 1, lastCount);
+    }
+
+    update();
+}
+
+void Heatmap::renderAll()
+{
+    if (!survey || !survey->isOpen())
+    {
+        image = QImage();
+        update();
+        return;
+    }
+
+    image = QImage(survey->bins(), HEATMAP_LINES, QImage::Format_RGB32);
+    image.fill(palette[0]);
+
+    quint64 count = survey->count();
+    lastCount = count;
+
+    quint64 newest = count > (quint64)offset ? count - offset : 0;  //Exclusive
+    for (int line = HEATMAP_LINES - 1; line >= 0 && newest > 0; line--)
+    {
+        newest--;
+        renderRow(line, newest);
+    }
+
+    update();
+}
+
+void Heatmap::renderRow(int line, quint64 n)
+{
+    const qint8 *levels = survey->row(n, nullptr);
+    QRgb *dest = reinterpret_cast<QRgb *>(image.scanLine(line));
+    int bins = image.width();
+
+    if (!levels)
+    {
+        for (int i = 0; i < bins; i++) dest[i] = palette[0];
+        return;
+    }
+
+    for (int i = 0; i < bins; i++) dest[i] = palette[quint8(levels[i] + 128)];
+}
+
+void Heatmap::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+
+    painter.fillRect(rect(), Qt::black);
+    if (!image.isNull()) painter.drawImage(rect(), image);
+}
@@ -0,0 +1,58 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef HEATMAP_H
+#define HEATMAP_H
+
+#include <QWidget>
+#include <QImage>
+#include <QVector>
+
+class SurveyFile;
+
+class Heatmap : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit Heatmap(QWidget *parent = nullptr);
+
+    void setSurvey(SurveyFile *survey);
+
+public slots:
+    void rowAppended(); //New row in the survey file
+    void setOffset(int rows);   //Rows back from the newest, 0 = follow the newest
+    void setLevelRange(int min, int max);  //dB relative to S9
+
+protected:
+    void paintEvent(QPaintEvent *);
+
+private:
+    void renderAll();
+    void renderRow(int line, quint64 n);
+
+    SurveyFile *survey = nullptr;
+    QImage image;   //One line per row, newest at the bottom
+    QVector<QRgb> palette;  //Level to color
+    int offset;
+    int levelMin, levelMax;
+    quint64 lastCount;
+};
+
+#endif // HEATMAP_H
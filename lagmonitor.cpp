@@ -0,0 +1,130 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "lagmonitor.h"
+
+#include <QCoreApplication>
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+QAtomicPointer<const char> lagMarker;
+
+static QElapsedTimer lagClock;
+static QAtomicInteger<qint64> lagPong;  //Heartbeat execution time on the GUI thread (us), -1 pending
+
+
+LagMonitor::LagMonitor(QObject *parent)
+    : QObject{parent}
+{
+    lagClock.start();
+    waiting = false;
+    pingTime = 0;
+}
+
+void LagMonitor::start(int threshold, int interval)
+{
+    stallThreshold = qint64(threshold) * 1000;
+    pingInterval = qint64(interval) * 1000;
+    waiting = false;
+
+    if (!timer)
+    {
+        timer = new QTimer(this);
+        timer->setTimerType(Qt::PreciseTimer);
+        connect(timer, &QTimer::timeout, this, &LagMonitor::heartbeat);
+    }
+    timer->start(int(pingInterval / 1000));
+
+    qInfo() << "Lag monitor threshold" << threshold << "ms";
+}
+
+void LagMonitor::heartbeat()
+{
+    qint64 now = lagClock.nsecsElapsed() / 1000;
+
+    if (waiting)
+    {
+        qint64 pong = lagPong.loadAcquire();
+        if (pong < 0)   //GUI thread busy, sample the running scope
+        {
+            stallSamples[lagMarker.loadRelaxed()]++;
+            return;
+        }
+
+        qint64 lag = pong - pingTime;
+        lagHist.add(lag);
+        if (lag >= stallThreshold) stallEnd(lag);
+
+        waiting = false;
+        stallSamples.clear();
+    }
+
+    if (now - pingTime < pingInterval)  //Idle until the next heartbeat
+    {
+        timer->start(int((pingInterval - (now - pingTime)) / 1000) + 1);
+        return;
+    }
+
+    pingTime = now;
+    waiting = true;
+    lagPong.storeRelease(-1);
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [](){ lagPong.storeRelease(lagClock.nsecsElapsed() / 1000); }, Qt::QueuedConnection);
+    timer->start(5);    //Sample the running scope only while a heartbeat is pending
+}
+
+//* Stall attributed to the scope sampled most often while it lasted
+void LagMonitor::stallEnd(qint64 lag)
+{
+    const char *marker = nullptr;
+    int samples = 0;
+    for (auto i = stallSamples.constBegin(); i != stallSamples.constEnd(); ++i)
+    {
+        if (i.value() > samples)
+        {
+            marker = i.key();
+            samples = i.value();
+        }
+    }
+
+    QString name = marker ? QString(marker) : QString("(unmarked)");
+    qWarning() << "GUI stall" << lag / 1000 << "ms in" << name;
+
+    lagStall &stall = stalls[name];
+    stall.count++;
+    stall.total += lag;
+    stall.max = qMax(stall.max, lag);
+}
+
+void LagMonitor::stop()
+{
+    if (timer) timer->stop();
+    if (!lagHist.count()) return;
+
+    qInfo() << "Lag monitor:" << lagHist.count() << "heartbeats, lag p50" << lagHist.percentile(0.5) / 1000.0 << "ms p99" << lagHist.percentile(0.99) / 1000.0
+            << "ms max" << lagHist.max() / 1000.0 << "ms";
+
+    QList<QString> names = stalls.keys();
+    std::sort(names.begin(), names.end(), [this](const QString &a, const QString &b){ return stalls.value(a).total > stalls.value(b).total; });
+    for (const QString &name : names)
+    {
+        lagStall stall = stalls.value(name);
+        qInfo() << "  stall" << name << stall.count << "times, total" << stall.total / 1000 << "ms, max" << stall.max / 1000 << "ms";
+    }
+}
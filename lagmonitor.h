@@ -0,0 +1,84 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef LAGMONITOR_H
+#define LAGMONITOR_H
+
+#include <QObject>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+#include "rigstats.h"
+
+class QTimer;
+
+extern QAtomicPointer<const char> lagMarker;    //Scope currently executing on the GUI thread
+
+
+//* GUI event loop latency, a heartbeat posted to the GUI thread and timed from the monitor thread
+class LagMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LagMonitor(QObject *parent = nullptr);
+
+public slots:
+    void start(int threshold, int interval);    //ms
+    void stop();    //Logs the summary
+
+private slots:
+    void heartbeat();
+
+private:
+    struct lagStall
+    {
+        int count;
+        qint64 total;   //us
+        qint64 max;
+    };
+
+    QTimer *timer = nullptr;
+    qint64 stallThreshold;  //us
+    qint64 pingInterval;
+    qint64 pingTime;
+    bool waiting;
+
+    StatsHistogram lagHist;
+    QHash<const char *, int> stallSamples;  //Markers seen during the pending heartbeat
+    QHash<QString, lagStall> stalls;
+
+    void stallEnd(qint64 lag);
+};
+
+
+//* Marks a GUI thread scope for the stall attribution, nested scopes restore the outer one
+class LagScope
+{
+public:
+    explicit LagScope(const char *name) : previous(lagMarker.fetchAndStoreRelaxed(name)) {}
+    ~LagScope() { lagMarker.storeRelaxed(previous); }
+
+private:
+    const char *previous;
+};
+
+#endif // LAGMONITOR_H
@@ -26,6 +26,11 @@
 #include "dialogcommand.h"
 #include "dialogradioinfo.h"
 #include "dialognetrigctl.h"
+#include "dialogrotator.h"
+#include "dialogamplifier.h"
+#include "dialogsurvey.h"
+#include "dialogmemory.h"
+#include "dialogstats.h"
 
 #include "rigdaemon.h"
 #include "rigdata.h"
@@ -34,6 +39,16 @@
 #include "winkeyer.h"
 #include "netrigctl.h"
 #include "debuglogger.h"
+#include "rigfollow.h"
+#include "doppler.h"
+#include "rotdaemon.h"
+#include "ampdaemon.h"
+#include "rigmetrics.h"
+#include "lagmonitor.h"
+#include "flightrecorder.h"
+#include "survey.h"
+#include "rigtape.h"
+#include "rigtrace.h"
 
 #include <QDebug>
 #include <QMessageBox>
@@ -45,6 +60,14 @@
 #include <QApplication>
 #include <QCoreApplication>
 #include <QDir>
+#include <QActionGroup>
+#include <QKeySequence>
+#include <QAtomicInt>
+#include <QSignalBlocker>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
 
 #include <cwchar>   //c++ string library
 #include <rig.h>    //Hamlib
@@ -59,6 +82,14 @@ extern guiConfig guiConf;
 extern guiCommand guiCmd;
 extern voiceKeyerConfig voiceKConf;
 extern cwKeyerConfig cwKConf;
+extern rigSession rigSess[RIG_SESSION_MAX];
+extern int rigSessActive;
+extern rigFollowConfig followConf;
+extern dopplerConfig dopplerConf;
+extern rotConnection rotCom;
+extern ampConnection ampCom;
+extern scanConfig scanConf;
+extern QList<rigMacro> macroConf;
 
 int retcode;    //Return code from function
 int i;  //Index
@@ -70,15 +101,63 @@ const float fudge = 0.003;
 FILE* debugFile;
 
 
-QThread workerThread; //
-RigDaemon *rigDaemon = new RigDaemon;
+QThread workerThread[RIG_SESSION_MAX]; //One worker thread per rig session
+RigDaemon *sessDaemon[RIG_SESSION_MAX];
+RigDaemon *rigDaemon = nullptr; //RigDaemon of the active session
+QTimer *sessTimer[RIG_SESSION_MAX];  //Poll timer for background sessions
+guiCommand sessGuiCmd[RIG_SESSION_MAX]; //GUI commands of background sessions (not displayed)
+QAtomicInt sessPending[RIG_SESSION_MAX];    //Background poll queued and not yet executed
+QAction *sessAction[RIG_SESSION_MAX];   //Rig menu, one action per connection profile
+
+QThread followThread;   //Thread for the follower rig
+RigFollow *rigFollow = new RigFollow;
+
+Doppler doppler;    //Satellite Doppler engine
+freq_t dopplerDown, dopplerUp;  //Last corrected frequencies sent to the rig
+
+QThread rotThread;  //Thread for the rotator
+RotDaemon *rotDaemon = new RotDaemon;
+
+QThread ampThread;  //Thread for the amplifier
+AmpDaemon *ampDaemon = new AmpDaemon;
+
+QThread metricsThread;  //Thread for the metrics export
+RigMetrics *rigMetrics = new RigMetrics;
+
+QThread lagThread;  //Thread for the GUI lag monitor
+LagMonitor *lagMonitor = new LagMonitor;
+
+bool scanActive = false;    //Scan or survey loop owns the rig
+QString ampFault;   //Active amplifier fault, empty if none
+
+QFile beaconLog;    //Beacon monitor log file
+QString beaconTag;  //Current beacon slot
+double beaconFreq;
+qint64 beaconUtc;
+int beaconPeak;     //S-meter peak in the slot
+SurveyFile surveyFile;  //Band survey memory-mapped file
+QList<rigChannel> memoryBuffer;    //Memory channels read buffer
 
 QDialog *command = nullptr;
 QDialog *radioInfo = nullptr;
+QDialog *rotator = nullptr;
+QDialog *amplifier = nullptr;
+DialogSurvey *survey = nullptr;
+QDialog *stats = nullptr;
 
 WinKeyer *winkeyer = nullptr;
 netRigCtl *netrigctl = nullptr;
 
+quint64 guiDeferred = 0;    //Changed fields not yet shown, RIG_CHANGED_* mask
+
+//* True if the field changed and can be shown, a field with a command pending is deferred to the next guiUpdate
+static bool guiChanged(quint64 changed, quint64 field, bool pending)
+{
+    if (!(changed & field)) return false;
+    if (pending) guiDeferred |= field;
+    return !pending;
+}
+
 
 //***** MainWindow *****
 
@@ -89,6 +168,7 @@ MainWindow::MainWindow(QWidget *parent)
     ui->setupUi(this);
 
     QDir::setCurrent(QCoreApplication::applicationDirPath());   //set current path = application path
+    QThread::currentThread()->setObjectName("GUI");
 
     timer = new QTimer(this);   //timer for rigDaemon thread call
 
@@ -107,16 +187,92 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->lineEdit_vfoMain, &vfoDisplay::on_valueChanged, this, &MainWindow::on_vfoDisplayMainValueChanged);
     connect(ui->lineEdit_vfoSub, &vfoDisplay::on_valueChanged, this, &MainWindow::on_vfoDisplaySubValueChanged);
 
-    //* Thread for RigDaemon
-    rigDaemon->moveToThread(&workerThread); //
-    connect(&workerThread, &QThread::finished, rigDaemon, &QObject::deleteLater);
+    //* Thread for RigDaemon, one per rig session
+    for (int n = 0; n < RIG_SESSION_MAX; n++)
+    {
+        sessDaemon[n] = new RigDaemon;
+        workerThread[n].setObjectName(QString("Rig session %1").arg(n + 1));
+        sessDaemon[n]->moveToThread(&workerThread[n]);
+        connect(&workerThread[n], &QThread::finished, sessDaemon[n], &QObject::deleteLater);
+        connect(sessDaemon[n], &RigDaemon::resultReady, this, [this, n]()
+        {
+            if (n == rigSessActive) on_rigDaemonResultReady();  //Update the GUI only for the active session
+        });
+
+        connect(sessDaemon[n], &RigDaemon::scanStatus, this, &MainWindow::on_rigDaemonScanStatus);
+        connect(sessDaemon[n], &RigDaemon::scanFinished, this, &MainWindow::on_rigDaemonScanFinished);
+        connect(sessDaemon[n], &RigDaemon::scheduleFired, this, &MainWindow::on_rigDaemonScheduleFired);
+        connect(sessDaemon[n], &RigDaemon::scheduleEmpty, this, &MainWindow::on_rigDaemonScheduleEmpty);
+        connect(sessDaemon[n], &RigDaemon::macroDone, this, &MainWindow::on_rigDaemonMacroDone);
+
+        sessTimer[n] = new QTimer(this);
+        connect(sessTimer[n], &QTimer::timeout, this, [this, n](){ sessionUpdate(n); });
+
+        if (n) sessDaemon[n]->setState(&rigSess[n].get, &rigSess[n].set, &rigSess[n].cmd, &rigSess[n].cap, &sessGuiCmd[n]);
+        rigSess[n].rig = nullptr;
+
+        workerThread[n].start();
+    }
+    rigDaemon = sessDaemon[0];
+    rigSessActive = 0;
+    RigStats::setActive(&rigDaemon->stats);
+
+    QActionGroup *rigGroup = new QActionGroup(this);    //Rig menu, one session selected
+    for (int n = 0; n < RIG_SESSION_MAX; n++)
+    {
+        sessAction[n] = ui->menu_Rig->addAction(QString("Rig %1").arg(n+1), this, [this, n](){ setActiveSession(n); });
+        sessAction[n]->setCheckable(true);
+        sessAction[n]->setShortcut(QKeySequence(QString("Ctrl+%1").arg(n+1)));
+        rigGroup->addAction(sessAction[n]);
+    }
+    sessAction[0]->setChecked(true);
     connect(timer, &QTimer::timeout, this, &MainWindow::rigUpdate);
-    connect(rigDaemon, &RigDaemon::resultReady, this, &MainWindow::on_rigDaemonResultReady);
-    workerThread.start();
+
+    //* Thread for RigFollow
+    rigFollow->moveToThread(&followThread);
+    connect(&followThread, &QThread::finished, rigFollow, &QObject::deleteLater);
+    connect(rigFollow, &RigFollow::opened, this, &MainWindow::on_rigFollowOpened);
+    connect(rigFollow, &RigFollow::lagUpdated, this, &MainWindow::on_rigFollowLagUpdated);
+    followThread.start();
+
+    //* Thread for RotDaemon
+    rotDaemon->moveToThread(&rotThread);
+    connect(&rotThread, &QThread::finished, rotDaemon, &QObject::deleteLater);
+    rotThread.start();
+
+    //* Thread for AmpDaemon
+    ampDaemon->moveToThread(&ampThread);
+    connect(&ampThread, &QThread::finished, ampDaemon, &QObject::deleteLater);
+    connect(ampDaemon, &AmpDaemon::faultChanged, this, &MainWindow::on_ampFaultChanged);
+    ampThread.start();
+
+    //* Thread for RigMetrics
+    rigMetrics->moveToThread(&metricsThread);
+    connect(&metricsThread, &QThread::finished, rigMetrics, &QObject::deleteLater);
+    metricsThread.start();
+
+    //* Thread for LagMonitor
+    lagMonitor->moveToThread(&lagThread);
+    connect(&lagThread, &QThread::finished, lagMonitor, &QObject::deleteLater);
+    lagThread.start();
+
+    //* Timer for Doppler tracking
+    dopplerTimer = new QTimer(this);
+    connect(dopplerTimer, &QTimer::timeout, this, &MainWindow::dopplerUpdate);
 
     //* Load settings from catradio.ini
     loadGuiConfig("catradio.ini");  //load GUI config
-    loadRigConfig("catradio.ini");  //load Rig config
+    loadRigConfig("catradio.ini", &rigCom);  //load Rig config
+    for (int n = 1; n < RIG_SESSION_MAX; n++) loadRigConfig("catradio.ini", &rigSess[n].com, QString("Rig%1").arg(n+1));
+    for (int n = 0; n < RIG_SESSION_MAX; n++) sessAction[n]->setText(n ? rigSess[n].com.profile : rigCom.profile);   //Profile names in the Rig menu
+    loadFollowConfig("catradio.ini");   //load Follow rig config
+    loadDopplerConfig("catradio.ini");  //load Doppler config
+    loadRotatorConfig("catradio.ini");  //load Rotator config
+    loadAmplifierConfig("catradio.ini");    //load Amplifier config
+    loadScanConfig("catradio.ini"); //load Scan config
+    loadMacroConfig("catradio.ini");    //load Macros
+    loadMetricsConfig("catradio.ini");  //load Metrics export
+    loadLagMonitorConfig("catradio.ini");   //load GUI lag monitor
     //Voice memory
     if (guiConf.voiceKeyerMode == 1)    //CatRadio Voice Keyer
     {
@@ -131,7 +287,8 @@ MainWindow::MainWindow(QWidget *parent)
     }
 
     //* Debug
-    debugLogger::install("catradio.log");
+    if (guiConf.debugBinary) debugLogger::install("catradio.blog", true);
+    else debugLogger::install("catradio.log");
     if (guiConf.debugMode) debugLogger::setDebugLevel(QtInfoMsg);
     else debugLogger::setDebugLevel(QtFatalMsg);
 
@@ -144,6 +301,14 @@ MainWindow::MainWindow(QWidget *parent)
     if ((debugFile=fopen("hamlib.log","w+")) == NULL) rig_set_debug_level(RIG_DEBUG_NONE);
     else rig_set_debug_file(debugFile);
 
+    //Hamlib flight recorder, trace level in memory, hamlib.log keeps the level above
+    QSettings flightConfig(QString("catradio.ini"), QSettings::IniFormat);
+    if (flightConfig.value("FlightRecorder/enable", true).toBool())
+    {
+        flightRecorder.install(debugFile, guiConf.debugMode ? RIG_DEBUG_VERBOSE : RIG_DEBUG_WARN);
+        ui->action_FlightRecorder->setEnabled(true);
+    }
+
     //* Style
     //ui->pushButton_PTT->setStyleSheet("QPushButton::checked {font: bold; color: red;}");
 
@@ -195,9 +360,9 @@ MainWindow::MainWindow(QWidget *parent)
     ui->progressBar_Smeter->setGateValue(80);
     ui->progressBar_Smeter->setValue(-54);
     ui->progressBar_Smeter->resetPeakValue();
-    ui->progressBar_Smeter->setPeakFactor(rigCom.rigRefresh/1000.0);
+    ui->progressBar_Smeter->setBallistics(guiConf.meterAttack, guiConf.meterDecay, guiConf.meterPeakDecay);
     ui->progressBar_subMeter->resetPeakValue();
-    ui->progressBar_subMeter->setPeakFactor(rigCom.rigRefresh/1000.0);
+    ui->progressBar_subMeter->setBallistics(guiConf.meterAttack, guiConf.meterDecay, guiConf.meterPeakDecay);
 
     //VFO
     ui->lineEdit_vfoMain->setValue(0);
@@ -216,6 +381,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     //Auto connect
     if (rigCom.autoConnect) ui->pushButton_Connect->toggle();
+    for (int n = 1; n < RIG_SESSION_MAX; n++) if (rigSess[n].com.standby) sessionConnect(n);   //Warm standby profiles
 
     //netrigctl
     if (!netrigctl) netrigctl = new netRigCtl;
@@ -225,18 +391,50 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
-    workerThread.quit(); //
-    workerThread.wait();
+    timer->stop();
+    for (int n = 0; n < RIG_SESSION_MAX; n++) sessTimer[n]->stop();
 
-    if (rigCom.connected)
+    for (int n = 0; n < RIG_SESSION_MAX; n++)
     {
-        timer->stop();
+        sessDaemon[n]->scanStop();  //End a scan, survey, memory or macro loop, quit() is only seen by the event loop
+        workerThread[n].quit(); //
+        workerThread[n].wait();
+    }
+
+    followThread.quit();    //RigFollow closes the follower rig on delete
+    followThread.wait();
+
+    rotThread.quit();   //RotDaemon closes the rotator on delete
+    rotThread.wait();
 
+    ampThread.quit();   //AmpDaemon closes the amplifier on delete
+    ampThread.wait();
+
+    metricsThread.quit();
+    metricsThread.wait();
+
+    QMetaObject::invokeMethod(lagMonitor, &LagMonitor::stop, Qt::BlockingQueuedConnection);  //Log the stall summary
+    lagThread.quit();
+    lagThread.wait();
+
+    if (rigCom.connected)
+    {
         rigCom.connected = 0;
         rig_close(my_rig);  //Close the communication to the rig
         rig_cleanup(my_rig);    //Release rig handle and free associated memory
     }
 
+    for (int n = 0; n < RIG_SESSION_MAX; n++)    //Parked sessions
+    {
+        if (n != rigSessActive && rigSess[n].com.connected)
+        {
+            rigSess[n].com.connected = 0;
+            rig_close(rigSess[n].rig);
+            rig_cleanup(rigSess[n].rig);
+        }
+    }
+
+    flightRecorder.closeFile();
     fclose(debugFile);  //Close hamlib.log
 
     if (guiConf.cwKeyerMode == 1)
@@ -250,6 +448,10 @@ MainWindow::~MainWindow()
 
     if (command) delete command;    //deallocate *command
     if (radioInfo) delete radioInfo;  //deallocate *radioInfo
+    if (rotator) delete rotator;  //deallocate *rotator
+    if (amplifier) delete amplifier;  //deallocate *amplifier
+    if (survey) delete survey;  //deallocate *survey
+    if (stats) delete stats;  //deallocate *stats
 
     if (netrigctl)  //deallocate *netrigctl
     {
@@ -265,6 +467,7 @@ MainWindow::~MainWindow()
     delete ui;
 
     qInfo() << "Close CatRadio";
+    debugLogger::uninstall();   //Flush the log
 }
 
 
@@ -481,6 +684,9 @@ void MainWindow::guiInit()
     guiCmd.antList = 1; //update antenna list
     guiCmd.toneList = 1;    //update tone list
     guiCmd.tabList = 1; //select tab
+
+    guiDeferred = 0;
+    rigDaemon->markAllChanged();    //Refresh every widget at the next guiUpdate
 }
 
 
@@ -493,7 +699,11 @@ void MainWindow::loadGuiConfig(QString configFileName)
     guiConf.cwKeyerMode = configFile.value("cwKeyerMode", 0).toInt();
     guiConf.voiceKeyerMode = configFile.value("voiceKeyerMode", 0).toInt();
     guiConf.peakHold = configFile.value("peakHold", true).toBool();
+    guiConf.meterAttack = configFile.value("meterAttack", 20).toInt();
+    guiConf.meterDecay = configFile.value("meterDecay", 150).toInt();
+    guiConf.meterPeakDecay = configFile.value("meterPeakDecay", 1000).toInt();
     guiConf.debugMode = configFile.value("debugMode", false).toBool();
+    guiConf.debugBinary = configFile.value("debugBinary", false).toBool();
     guiConf.rigModelSort = configFile.value("rigModelSort", false).toBool();
 
     //for (size_t i=0; i<4; i++)
@@ -512,9 +722,13 @@ void MainWindow::loadGuiConfig(QString configFileName)
 }
 
 
-void MainWindow::loadRigConfig(QString configFileName)
+void MainWindow::loadRigConfig(QString configFileName, rigConnection *rigConn, QString group)
 {
     QSettings configFile(configFileName, QSettings::IniFormat);
+    rigConnection &rigCom = *rigConn;
+
+    if (!group.isEmpty()) configFile.beginGroup(group); //Additional rig sessions are stored in their own group
+    else group = "Rig1";
 
     rigCom.rigModel = configFile.value("rigModel", 0).toUInt();
     rigCom.rigPort = configFile.value("rigPort").toString();
@@ -532,6 +746,10 @@ void MainWindow::loadRigConfig(QString configFileName)
     rigCom.fullPoll = configFile.value("fullPolling", true).toBool();
     rigCom.autoConnect = configFile.value("autoConnect", false).toBool();
     rigCom.autoPowerOn = configFile.value("autoPowerOn", false).toBool();
+    rigCom.pollBudget = configFile.value("pollBudget", 500).toUInt();
+    rigCom.profile = configFile.value("profileName", group.insert(3, ' ')).toString();
+    rigCom.standby = configFile.value("standby", false).toBool();
+    rigCom.connected = 0;
 }
 
 
@@ -584,6 +802,146 @@ void MainWindow::audioOutputInit(QString configFileName)
 }
 
 
+void MainWindow::loadFollowConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    followConf.rigModel = configFile.value("Follow/rigModel", 1).toUInt();    //Dummy by default
+    followConf.rigPort = configFile.value("Follow/rigPort", "").toString();
+    followConf.serialSpeed = configFile.value("Follow/serialSpeed", 0).toUInt();
+    followConf.offset = configFile.value("Follow/offset", 0).toInt();
+    followConf.followMode = configFile.value("Follow/followMode", true).toBool();
+}
+
+
+void MainWindow::loadDopplerConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    dopplerConf.tleFile = configFile.value("Doppler/tleFile", "amateur.txt").toString();
+    dopplerConf.satName = configFile.value("Doppler/satName", "").toString();
+    dopplerConf.downlink = configFile.value("Doppler/downlink", 0).toDouble();
+    dopplerConf.uplink = configFile.value("Doppler/uplink", 0).toDouble();
+    dopplerConf.latitude = configFile.value("Doppler/latitude", 0).toDouble();
+    dopplerConf.longitude = configFile.value("Doppler/longitude", 0).toDouble();
+    dopplerConf.altitude = configFile.value("Doppler/altitude", 0).toDouble();
+    dopplerConf.rate = qBound(1, configFile.value("Doppler/rate", 2).toInt(), 5);
+    dopplerConf.step = configFile.value("Doppler/step", 10).toInt();
+}
+
+
+void MainWindow::loadRotatorConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    rotCom.rotModel = configFile.value("Rotator/rotModel", 1).toUInt();  //Dummy by default
+    rotCom.rotPort = configFile.value("Rotator/rotPort", "").toString();
+    rotCom.serialSpeed = configFile.value("Rotator/serialSpeed", 0).toUInt();
+    rotCom.pollFast = configFile.value("Rotator/pollFast", 250).toInt();
+    rotCom.pollSlow = configFile.value("Rotator/pollSlow", 2000).toInt();
+}
+
+
+void MainWindow::loadAmplifierConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    ampCom.ampModel = configFile.value("Amplifier/ampModel", 1).toUInt();    //Dummy by default
+    ampCom.ampPort = configFile.value("Amplifier/ampPort", "").toString();
+    ampCom.serialSpeed = configFile.value("Amplifier/serialSpeed", 0).toUInt();
+    ampCom.pollFast = configFile.value("Amplifier/pollFast", 100).toInt();
+    ampCom.pollSlow = configFile.value("Amplifier/pollSlow", 1000).toInt();
+}
+
+
+void MainWindow::loadScanConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    scanConf.start = configFile.value("Scan/start", 14000000).toDouble();
+    scanConf.stop = configFile.value("Scan/stop", 14350000).toDouble();
+    scanConf.step = configFile.value("Scan/step", 5000).toDouble();
+    scanConf.threshold = configFile.value("Scan/threshold", -20).toInt();   //about S6
+    scanConf.hang = configFile.value("Scan/hang", 2000).toInt();
+    scanConf.dwell = configFile.value("Scan/dwell", 5).toInt();
+    scanConf.dwellMax = configFile.value("Scan/dwellMax", 200).toInt();
+
+    scanConf.list.clear();  //Channel list (Hz), comma separated
+    const QStringList list = configFile.value("Scan/list").toStringList();
+    for (const QString &channel : list)
+    {
+        bool ok;
+        freq_t freq = channel.trimmed().toDouble(&ok);
+        if (ok && freq > 0) scanConf.list.append(freq);
+    }
+}
+
+
+//* Prometheus metrics export
+//* [Metrics] mode=0 off, 1 textfile (node_exporter), 2 HTTP on localhost
+void MainWindow::loadMetricsConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    int mode = configFile.value("Metrics/mode", METRICS_OFF).toInt();
+    QString fileName = configFile.value("Metrics/file", "catradio.prom").toString();
+    int interval = configFile.value("Metrics/interval", 15).toInt();
+    int port = configFile.value("Metrics/port", 9469).toInt();
+
+    QMetaObject::invokeMethod(rigMetrics, [mode, fileName, interval, port](){ rigMetrics->start(mode, fileName, interval, port); }, Qt::QueuedConnection);
+}
+
+
+//* GUI event loop lag monitor, stalls over threshold (ms) are logged with the running scope
+void MainWindow::loadLagMonitorConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    if (!configFile.value("LagMonitor/enable", false).toBool()) return; //Diagnostic, off unless enabled
+    int threshold = configFile.value("LagMonitor/threshold", 50).toInt();
+    int interval = configFile.value("LagMonitor/interval", 20).toInt();
+
+    QMetaObject::invokeMethod(lagMonitor, [threshold, interval](){ lagMonitor->start(threshold, interval); }, Qt::QueuedConnection);
+}
+
+
+//* Macros, parsed once at load
+//* [Macros] size=1, 1\name=FT8 20m, 1\keys=Ctrl+Shift+1, 1\script="freq 14.074; mode USB-D; bw 2.7k; agc fast; power 30"
+void MainWindow::loadMacroConfig(QString configFileName)
+{
+    QSettings configFile(configFileName, QSettings::IniFormat);
+
+    macroConf.clear();
+    ui->menu_Macro->clear();
+
+    int size = configFile.beginReadArray("Macros");
+    for (int i = 0; i < size; i++)
+    {
+        configFile.setArrayIndex(i);
+
+        rigMacro macro;
+        macro.name = configFile.value("name", QString("Macro %1").arg(i+1)).toString();
+        macro.keys = configFile.value("keys", i < 9 ? QString("Ctrl+Shift+%1").arg(i+1) : "").toString();
+
+        QString error;
+        macro.steps = macro_parse(configFile.value("script").toStringList().join(";"), &error);   //Unquoted commas are read as a list
+        if (!error.isEmpty())
+        {
+            qWarning() << "Macro" << macro.name << error;
+            continue;
+        }
+        macroConf.append(macro);
+
+        int index = macroConf.size() - 1;
+        QAction *action = ui->menu_Macro->addAction(macro.name, this, [this, index](){ runMacro(index); });
+        action->setShortcut(QKeySequence(macro.keys));
+    }
+    configFile.endArray();
+
+    ui->menu_Macro->setEnabled(!macroConf.isEmpty());
+}
+
+
 void MainWindow::loadCwKeyerConfig(QString configFileName)
 {
     QSettings configFile(configFileName, QSettings::IniFormat);
@@ -607,8 +965,15 @@ void MainWindow::loadCwKeyerConfig(QString configFileName)
 
 void MainWindow::guiUpdate()
 {
+    TraceScope trace("gui", "guiUpdate");
+    LagScope lag("MainWindow::guiUpdate");
+
+    //Only the widgets of the changed fields are updated, updates skipped for a pending command are kept for the next tick
+    quint64 changed = rigDaemon->takeChanges() | guiDeferred;
+    guiDeferred = 0;
+
     //* Power button
-    if (rigGet.onoff == RIG_POWER_ON)
+    if (rigGet.onoff == RIG_POWER_ON && (changed & RIG_CHANGED_POWER))
     {
         ui->pushButton_Power->setChecked(true);
         //ui->pushButton_Power->setStyleSheet("QPushButton {color: limegreen;}");
@@ -629,28 +994,32 @@ void MainWindow::guiUpdate()
             //Reset VFOs
             rigGet.freqMain = 0;
             rigGet.freqSub = 0;
+            changed |= RIG_CHANGED_FREQ_MAIN | RIG_CHANGED_FREQ_SUB;
 
             ui->statusbar->showMessage("Radio off");
         }
     }
 
     //* VFOs
-    if (!rigCmd.freqMain) ui->lineEdit_vfoMain->setValue(rigGet.freqMain);
-    if (!rigCmd.freqSub) ui->lineEdit_vfoSub->setValue(rigGet.freqSub);
+    if (guiChanged(changed, RIG_CHANGED_FREQ_MAIN, rigCmd.freqMain)) ui->lineEdit_vfoMain->setValue(rigGet.freqMain);
+    if (guiChanged(changed, RIG_CHANGED_FREQ_SUB, rigCmd.freqSub)) ui->lineEdit_vfoSub->setValue(rigGet.freqSub);
 
-    ui->label_vfoMain->setText(rig_strvfo(rigGet.vfoMain));
-    switch (rigGet.vfoMain)
+    if (changed & RIG_CHANGED_VFO)
     {
-    case RIG_VFO_A: rigGet.vfoSub = RIG_VFO_B; break;
-    case RIG_VFO_B: rigGet.vfoSub = RIG_VFO_A; break;
-    case RIG_VFO_MAIN: rigGet.vfoSub = RIG_VFO_SUB; break;
-    case RIG_VFO_SUB: rigGet.vfoSub = RIG_VFO_MAIN; break;
+        ui->label_vfoMain->setText(rig_strvfo(rigGet.vfoMain));
+        switch (rigGet.vfoMain)
+        {
+        case RIG_VFO_A: rigGet.vfoSub = RIG_VFO_B; break;
+        case RIG_VFO_B: rigGet.vfoSub = RIG_VFO_A; break;
+        case RIG_VFO_MAIN: rigGet.vfoSub = RIG_VFO_SUB; break;
+        case RIG_VFO_SUB: rigGet.vfoSub = RIG_VFO_MAIN; break;
+        }
+        ui->label_vfoSub->setText(rig_strvfo(rigGet.vfoSub));
     }
-    ui->label_vfoSub->setText(rig_strvfo(rigGet.vfoSub));
 
     //* Mode
-    if (!rigCmd.mode) ui->comboBox_Mode->setCurrentText(rig_strrmode(rigGet.mode));
-    if (!rigCmd.modeSub) ui->comboBox_ModeSub->setCurrentText(rig_strrmode(rigGet.modeSub));
+    if (guiChanged(changed, RIG_CHANGED_MODE, rigCmd.mode)) ui->comboBox_Mode->setCurrentText(rig_strrmode(rigGet.mode));
+    if (guiChanged(changed, RIG_CHANGED_MODE_SUB, rigCmd.modeSub)) ui->comboBox_ModeSub->setCurrentText(rig_strrmode(rigGet.modeSub));
 
     if (guiCmd.tabList) //Select appropriate mode function tab
     {
@@ -698,11 +1067,12 @@ void MainWindow::guiUpdate()
             //else qDebug() << "vuoto" << rigGet.mode;
        }
        //ui->comboBox_BW->model()->sort(0, Qt::DescendingOrder);
+       changed |= RIG_CHANGED_BW;   //List rebuilt, select again
        guiCmd.bwidthList = 0;
     }
 
-    if (!rigCmd.bwidth) ui->comboBox_BW->setCurrentText(QString::number(rigGet.bwidth));
-    ui->checkBox_NAR->setChecked(rigGet.bwNarrow);
+    if (guiChanged(changed, RIG_CHANGED_BW, rigCmd.bwidth)) ui->comboBox_BW->setCurrentText(QString::number(rigGet.bwidth));
+    if (changed & RIG_CHANGED_BW) ui->checkBox_NAR->setChecked(rigGet.bwNarrow);
 
     //* Range list
     if (guiCmd.rangeList)
@@ -773,139 +1143,183 @@ void MainWindow::guiUpdate()
             }
         }
 
+        changed |= RIG_CHANGED_TONE;    //List rebuilt, select again
         guiCmd.toneList = 0;
     }
 
     //* RF
-    if (!rigCmd.tuner) ui->radioButton_Tuner->setChecked(rigGet.tuner);
-    if (!rigCmd.agc) ui->comboBox_AGC->setCurrentText(rig_stragclevel(rigGet.agc));
-    if (!rigCmd.att) ui->comboBox_Att->setCurrentText(QString::number(rigGet.att));
-    if (!rigCmd.pre) ui->comboBox_Preamp->setCurrentText(QString::number(rigGet.pre));
+    if (guiChanged(changed, RIG_CHANGED_TUNER, rigCmd.tuner)) ui->radioButton_Tuner->setChecked(rigGet.tuner);
+    if (guiChanged(changed, RIG_CHANGED_AGC, rigCmd.agc)) ui->comboBox_AGC->setCurrentText(rig_stragclevel(rigGet.agc));
+    if (guiChanged(changed, RIG_CHANGED_ATT, rigCmd.att)) ui->comboBox_Att->setCurrentText(QString::number(rigGet.att));
+    if (guiChanged(changed, RIG_CHANGED_PRE, rigCmd.pre)) ui->comboBox_Preamp->setCurrentText(QString::number(rigGet.pre));
 
     //* Split
-    if (rigGet.split == RIG_SPLIT_ON)
+    if (changed & (RIG_CHANGED_SPLIT | RIG_CHANGED_VFO))
     {
-        ui->pushButton_Split->setChecked(true);
-        if (rigGet.vfoSub == rigGet.vfoTx)
+        if (rigGet.split == RIG_SPLIT_ON)
         {
-            ui->label_vfoMainRxTx->setText("RX");
-            ui->label_vfoSubRxTx->setText("TX");
+            ui->pushButton_Split->setChecked(true);
+            if (rigGet.vfoSub == rigGet.vfoTx)
+            {
+                ui->label_vfoMainRxTx->setText("RX");
+                ui->label_vfoSubRxTx->setText("TX");
+            }
+            else
+            {
+                ui->label_vfoMainRxTx->setText("TX");
+                ui->label_vfoSubRxTx->setText("RX");
+            }
         }
         else
         {
-            ui->label_vfoMainRxTx->setText("TX");
-            ui->label_vfoSubRxTx->setText("RX");
+            ui->pushButton_Split->setChecked(false);
+            ui->label_vfoMainRxTx->setText("RX TX");
+            ui->label_vfoSubRxTx->setText("");
         }
     }
-    else
-    {
-        ui->pushButton_Split->setChecked(false);
-        ui->label_vfoMainRxTx->setText("RX TX");
-        ui->label_vfoSubRxTx->setText("");
-    }
 
     //* PTT & Meter
-    if (rigGet.ptt == RIG_PTT_ON)
+    if (changed & (RIG_CHANGED_PTT | RIG_CHANGED_VFO))  //TX VFO highlight, setStyleSheet repolishes the label
     {
-        //ui->pushButton_PTT->setChecked(true);
-        if (rigGet.vfoTx == rigGet.vfoSub) ui->label_vfoSub->setStyleSheet("QLabel {background-color: red}");
-        else ui->label_vfoMain->setStyleSheet("QLabel {background-color: red}");
+        bool txSub = rigGet.ptt == RIG_PTT_ON && rigGet.vfoTx == rigGet.vfoSub;
+        bool txMain = rigGet.ptt == RIG_PTT_ON && rigGet.vfoTx != rigGet.vfoSub;
+        ui->label_vfoSub->setStyleSheet(txSub ? "QLabel {background-color: red}" : "QLabel {}");
+        ui->label_vfoMain->setStyleSheet(txMain ? "QLabel {background-color: red}" : "QLabel {}");
+    }
 
-        //Smeter and subMeter
-        if (!ui->progressBar_Smeter->getTx())
-        {
-            ui->progressBar_Smeter->setTx(true);
-            ui->progressBar_Smeter->setValue(0);
-            ui->progressBar_Smeter->resetPeakValue();
-        }
-        ui->progressBar_Smeter->setValue(rigGet.powerMeter.f*100);
-        ui->progressBar_subMeter->setValue(rigGet.subMeter.f);
-        if (rigGet.hiSWR.f > 2) ui->label_hiSWR->setVisible(true);
+    //Voice keyer
+    if (rigGet.ptt == RIG_PTT_ON && guiConf.voiceKeyerMode == 1 && rigCmd.voiceSend) audioPlayer->play();
 
-        //Voice keyer
-        if (guiConf.voiceKeyerMode == 1 && rigCmd.voiceSend) audioPlayer->play();
-    }
-    else    //RIG_PTT_OFF
+    if (changed & (RIG_CHANGED_PTT | RIG_CHANGED_METER))
     {
-        //ui->pushButton_PTT->setChecked(false);
-        if (rigGet.vfoTx == rigGet.vfoSub) ui->label_vfoSub->setStyleSheet("QLabel {}");
-        else ui->label_vfoMain->setStyleSheet("QLabel {}");
+        if (rigGet.ptt == RIG_PTT_ON)
+        {
+            //ui->pushButton_PTT->setChecked(true);
 
-        if (ui->progressBar_Smeter->getTx())
+            //Smeter and subMeter
+            if (!ui->progressBar_Smeter->getTx())
+            {
+                ui->progressBar_Smeter->setTx(true);
+                ui->progressBar_Smeter->setValue(0);
+                ui->progressBar_Smeter->resetPeakValue();
+            }
+            ui->progressBar_Smeter->setValue(rigGet.powerMeter.f*100);
+            ui->progressBar_subMeter->setValue(rigGet.subMeter.f);
+            if (rigGet.hiSWR.f > 2) ui->label_hiSWR->setVisible(true);
+        }
+        else    //RIG_PTT_OFF
         {
-            ui->progressBar_Smeter->setTx(false);
-            ui->progressBar_Smeter->setValue(-54);
-            ui->progressBar_Smeter->resetPeakValue();
-            ui->label_hiSWR->setVisible(false);
-            //if (rigSet.meter == RIG_LEVEL_SWR) ui->progressBar_subMeter->setValue(1.0);
-            //else ui->progressBar_subMeter->setValue(0.0);
-            //ui->progressBar_subMeter->resetPeakValue();
+            //ui->pushButton_PTT->setChecked(false);
+            if (ui->progressBar_Smeter->getTx())
+            {
+                ui->progressBar_Smeter->setTx(false);
+                ui->progressBar_Smeter->setValue(-54);
+                ui->progressBar_Smeter->resetPeakValue();
+                ui->label_hiSWR->setVisible(false);
+                //if (rigSet.meter == RIG_LEVEL_SWR) ui->progressBar_subMeter->setValue(1.0);
+                //else ui->progressBar_subMeter->setValue(0.0);
+                //ui->progressBar_subMeter->resetPeakValue();
+            }
+            ui->progressBar_Smeter->setValue(rigGet.sMeter.i);
+            if (rigSet.meter == RIG_LEVEL_SWR) ui->progressBar_subMeter->setValue(1.0);
+            else ui->progressBar_subMeter->setValue(0.0);
         }
-        ui->progressBar_Smeter->setValue(rigGet.sMeter.i);
-        if (rigSet.meter == RIG_LEVEL_SWR) ui->progressBar_subMeter->setValue(1.0);
-        else ui->progressBar_subMeter->setValue(0.0);
     }
 
     //* Levels
-    if (!ui->verticalSlider_RFpower->isSliderDown() && !rigCmd.rfPower) ui->verticalSlider_RFpower->setValue((int)(rigGet.rfPower*100+fudge));
-    if (!ui->verticalSlider_RFgain->isSliderDown() && !rigCmd.rfGain) ui->verticalSlider_RFgain->setValue((int)(rigGet.rfGain*100+fudge));
-    if (!ui->verticalSlider_AFGain->isSliderDown() && !rigCmd.afGain) ui->verticalSlider_AFGain->setValue((int)(rigGet.afGain*100+fudge));
-    if (!ui->verticalSlider_Squelch->isSliderDown() && !rigCmd.squelch) ui->verticalSlider_Squelch->setValue((int)(rigGet.squelch*100+fudge));
+    if (guiChanged(changed, RIG_CHANGED_RF_POWER, ui->verticalSlider_RFpower->isSliderDown() || rigCmd.rfPower)) ui->verticalSlider_RFpower->setValue((int)(rigGet.rfPower*100+fudge));
+    if (guiChanged(changed, RIG_CHANGED_RF_GAIN, ui->verticalSlider_RFgain->isSliderDown() || rigCmd.rfGain)) ui->verticalSlider_RFgain->setValue((int)(rigGet.rfGain*100+fudge));
+    if (guiChanged(changed, RIG_CHANGED_AF_GAIN, ui->verticalSlider_AFGain->isSliderDown() || rigCmd.afGain)) ui->verticalSlider_AFGain->setValue((int)(rigGet.afGain*100+fudge));
+    if (guiChanged(changed, RIG_CHANGED_SQUELCH, ui->verticalSlider_Squelch->isSliderDown() || rigCmd.squelch)) ui->verticalSlider_Squelch->setValue((int)(rigGet.squelch*100+fudge));
 
     //* MIC
-    if (!ui->verticalSlider_micGain->isSliderDown() && !rigCmd.micGain) ui->verticalSlider_micGain->setValue((int)(rigGet.micGain*100+fudge));
-    if (!ui->verticalSlider_micMonitor->isSliderDown() && !rigCmd.micMonLevel) ui->verticalSlider_micMonitor->setValue((int)(rigGet.micMonLevel*100+fudge));
-    if (!ui->verticalSlider_micCompressor->isSliderDown() && !rigCmd.micCompLevel) ui->verticalSlider_micCompressor->setValue((int)(rigGet.micCompLevel*100+fudge));
-    if (!rigCmd.micComp) ui->checkBox_micCompressor->setChecked(rigGet.micComp);
-    if (!rigCmd.micMon) ui->checkBox_micMonitor->setChecked(rigGet.micMon);
+    if (changed & RIG_CHANGED_MIC)
+    {
+        if (!ui->verticalSlider_micGain->isSliderDown() && !rigCmd.micGain) ui->verticalSlider_micGain->setValue((int)(rigGet.micGain*100+fudge));
+        else guiDeferred |= RIG_CHANGED_MIC;
+        if (!ui->verticalSlider_micMonitor->isSliderDown() && !rigCmd.micMonLevel) ui->verticalSlider_micMonitor->setValue((int)(rigGet.micMonLevel*100+fudge));
+        else guiDeferred |= RIG_CHANGED_MIC;
+        if (!ui->verticalSlider_micCompressor->isSliderDown() && !rigCmd.micCompLevel) ui->verticalSlider_micCompressor->setValue((int)(rigGet.micCompLevel*100+fudge));
+        else guiDeferred |= RIG_CHANGED_MIC;
+        if (!rigCmd.micComp) ui->checkBox_micCompressor->setChecked(rigGet.micComp);
+        else guiDeferred |= RIG_CHANGED_MIC;
+        if (!rigCmd.micMon) ui->checkBox_micMonitor->setChecked(rigGet.micMon);
+        else guiDeferred |= RIG_CHANGED_MIC;
+    }
 
     //* Filter
-    if (!rigCmd.noiseBlanker) ui->checkBox_NB->setChecked(rigGet.noiseBlanker);
-    if (!rigCmd.noiseBlanker2) ui->checkBox_NB2->setChecked(rigGet.noiseBlanker2);
-    if (!rigCmd.noiseReduction) ui->checkBox_NR->setChecked(rigGet.noiseReduction);
-    if (!rigCmd.noiseReductionLevel) ui->spinBox_NR->setValue((int)(rigGet.noiseReductionLevel*ui->spinBox_NR->maximum()+fudge));
-    if (!rigCmd.notchFilter) ui->checkBox_NF->setChecked(rigGet.notchFilter);
-    if (!ui->horizontalSlider_IFshift->isSliderDown() && !rigCmd.ifShift) ui->horizontalSlider_IFshift->setValue(rigGet.ifShift);
-
-    //* Clarifier
-    if (!rigCmd.clar) ui->checkBox_clar->setChecked(rigGet.clar);
-    if (rigSet.xit)
+    if (changed & RIG_CHANGED_NB)
     {
-        ui->radioButton_clarXIT->setChecked(true);
-        if (!ui->horizontalSlider_clar->isSliderDown() && !rigCmd.clar) ui->horizontalSlider_clar->setValue(rigGet.xitOffset);
+        if (!rigCmd.noiseBlanker) ui->checkBox_NB->setChecked(rigGet.noiseBlanker);
+        else guiDeferred |= RIG_CHANGED_NB;
+        if (!rigCmd.noiseBlanker2) ui->checkBox_NB2->setChecked(rigGet.noiseBlanker2);
+        else guiDeferred |= RIG_CHANGED_NB;
     }
-    else    //rigSet.rit
+    if (changed & RIG_CHANGED_NR)
     {
-        ui->radioButton_clarRIT->setChecked(true);
-        if (!ui->horizontalSlider_clar->isSliderDown() && !rigCmd.clar) ui->horizontalSlider_clar->setValue(rigGet.ritOffset);
+        if (!rigCmd.noiseReduction) ui->checkBox_NR->setChecked(rigGet.noiseReduction);
+        else guiDeferred |= RIG_CHANGED_NR;
+        if (!rigCmd.noiseReductionLevel) ui->spinBox_NR->setValue((int)(rigGet.noiseReductionLevel*ui->spinBox_NR->maximum()+fudge));
+        else guiDeferred |= RIG_CHANGED_NR;
+    }
+    if (guiChanged(changed, RIG_CHANGED_NF, rigCmd.notchFilter)) ui->checkBox_NF->setChecked(rigGet.notchFilter);
+    if (guiChanged(changed, RIG_CHANGED_IF_SHIFT, ui->horizontalSlider_IFshift->isSliderDown() || rigCmd.ifShift)) ui->horizontalSlider_IFshift->setValue(rigGet.ifShift);
+
+    //* Clarifier
+    if (guiChanged(changed, RIG_CHANGED_CLAR, ui->horizontalSlider_clar->isSliderDown() || rigCmd.clar))
+    {
+        ui->checkBox_clar->setChecked(rigGet.clar);
+        if (rigSet.xit)
+        {
+            ui->radioButton_clarXIT->setChecked(true);
+            ui->horizontalSlider_clar->setValue(rigGet.xitOffset);
+        }
+        else    //rigSet.rit
+        {
+            ui->radioButton_clarRIT->setChecked(true);
+            ui->horizontalSlider_clar->setValue(rigGet.ritOffset);
+        }
     }
 
     //* CW
-    if (!rigCmd.bkin) ui->checkBox_BKIN->setChecked(rigGet.bkin);
-    if (!rigCmd.apf) ui->checkBox_APF->setChecked(rigGet.apf);
-    if (guiConf.cwKeyerMode == 0 && !rigCmd.wpm) ui->spinBox_WPM->setValue(rigGet.wpm);
+    if (changed & RIG_CHANGED_CW)
+    {
+        if (!rigCmd.bkin) ui->checkBox_BKIN->setChecked(rigGet.bkin);
+        else guiDeferred |= RIG_CHANGED_CW;
+        if (!rigCmd.apf) ui->checkBox_APF->setChecked(rigGet.apf);
+        else guiDeferred |= RIG_CHANGED_CW;
+        if (guiConf.cwKeyerMode == 0 && !rigCmd.wpm) ui->spinBox_WPM->setValue(rigGet.wpm);
+        else if (guiConf.cwKeyerMode == 0) guiDeferred |= RIG_CHANGED_CW;
+    }
 
     //* FM
-    if (rigGet.rptShift == RIG_RPT_SHIFT_MINUS && !rigCmd.rptShift) ui->radioButton_RPTshiftMinus->setChecked(true);    //-
-    else if (rigGet.rptShift == RIG_RPT_SHIFT_PLUS && !rigCmd.rptShift) ui->radioButton_RPTshiftPlus->setChecked(true); //+
-    else ui->radioButton_RPTshiftSimplex->setChecked(true); //Simplex
-    if (!rigCmd.rptOffset) ui->spinBox_RPToffset->setValue(rigGet.rptOffset/1000);  //Offset (kHz)
-
-    switch (rigGet.toneType)
+    if (guiChanged(changed, RIG_CHANGED_RPT, rigCmd.rptShift || rigCmd.rptOffset))
     {
-    case (1): ui->comboBox_toneType->setCurrentText("1750Hz"); break;
-    case (2): ui->comboBox_toneType->setCurrentText("TONE"); break;
-    case (3): ui->comboBox_toneType->setCurrentText("TSQL"); break;
-    case (4): ui->comboBox_toneType->setCurrentText("DCS"); break;
-    default: ui->comboBox_toneType->setCurrentText(""); break;
+        if (rigGet.rptShift == RIG_RPT_SHIFT_MINUS) ui->radioButton_RPTshiftMinus->setChecked(true);    //-
+        else if (rigGet.rptShift == RIG_RPT_SHIFT_PLUS) ui->radioButton_RPTshiftPlus->setChecked(true); //+
+        else ui->radioButton_RPTshiftSimplex->setChecked(true); //Simplex
+        ui->spinBox_RPToffset->setValue(rigGet.rptOffset/1000);  //Offset (kHz)
     }
 
-    if (rigGet.toneType == 2 || rigGet.toneType == 3) ui->comboBox_toneFreq->setCurrentText(QString::number(rigGet.tone/10.0));  //CTCSS
-    else if (rigGet.toneType == 4) ui->comboBox_toneFreq->setCurrentText(QString::number(rigGet.tone));  //DCS
+    if (changed & RIG_CHANGED_TONE)
+    {
+        switch (rigGet.toneType)
+        {
+        case (1): ui->comboBox_toneType->setCurrentText("1750Hz"); break;
+        case (2): ui->comboBox_toneType->setCurrentText("TONE"); break;
+        case (3): ui->comboBox_toneType->setCurrentText("TSQL"); break;
+        case (4): ui->comboBox_toneType->setCurrentText("DCS"); break;
+        default: ui->comboBox_toneType->setCurrentText(""); break;
+        }
+
+        if (rigGet.toneType == 2 || rigGet.toneType == 3) ui->comboBox_toneFreq->setCurrentText(QString::number(rigGet.tone/10.0));  //CTCSS
+        else if (rigGet.toneType == 4) ui->comboBox_toneFreq->setCurrentText(QString::number(rigGet.tone));  //DCS
+    }
 }
 
 void MainWindow::rigUpdate()
 {
+    LagScope lag("MainWindow::rigUpdate");
     rigDaemon->rigUpdate(my_rig, rigCom.fullPoll);
 }
 
@@ -913,6 +1327,235 @@ void MainWindow::rigUpdate()
 void MainWindow::on_rigDaemonResultReady()
 {
     guiUpdate();
+
+    if (rigFollow->isOpen()) rigFollow->setTarget(rigGet.freqMain, rigGet.mode);    //Follower rig, non blocking
+
+    if (rigGet.ptt == RIG_PTT_ON) ampTxInterlock(false); //Keyed from the rig or a keyer while the amplifier is faulted
+    ampDaemon->setTx(rigGet.ptt == RIG_PTT_ON || rigSet.ptt == RIG_PTT_ON);   //Amplifier poll rate
+}
+
+//* Scanner results
+void MainWindow::on_rigDaemonScanStatus(double freq, int strength, double rate, bool hold)
+{
+    rigGet.freqMain = freq; //The scan loop does not touch the state store
+    rigGet.sMeter.i = strength;
+
+    ui->lineEdit_vfoMain->setValue(freq);
+    ui->progressBar_Smeter->setValue(strength);
+
+    ui->statusbar->showMessage(QString("Scan %1 kHz  %2 dB  %3 ch/s%4").arg(freq/1000, 0, 'f', 1).arg(strength).arg(rate, 0, 'f', 1).arg(hold ? "  HOLD" : ""));
+}
+
+void MainWindow::on_rigDaemonScanFinished()
+{
+    scanActive = false;
+
+    {
+        const QSignalBlocker blocker(ui->action_Scan);
+        ui->action_Scan->setChecked(false);
+    }
+    if (survey) survey->on_surveyFinished();
+
+    rigSet.freqMain = rigGet.freqMain;
+    if (rigCom.connected && rigGet.onoff == RIG_POWER_ON) timer->start(rigCom.rigRefresh);  //Resume polling
+    ui->statusbar->showMessage("Scan stopped");
+}
+
+//* Amplifier TX interlock, drop PTT on fault
+void MainWindow::on_ampFaultChanged(QString fault)
+{
+    ampFault = fault;
+    if (fault.isEmpty()) return;
+
+    ampTxInterlock(true);
+    ui->statusbar->showMessage("Amplifier fault: " + fault);
+}
+
+//* Drop PTT while the amplifier reports a fault, immediate runs the PTT command now instead of at the next poll
+void MainWindow::ampTxInterlock(bool immediate)
+{
+    if (ampFault.isEmpty() || !rigCom.connected) return;
+    if (rigGet.ptt != RIG_PTT_ON && rigSet.ptt != RIG_PTT_ON) return;
+
+    if (rigSet.ptt != RIG_PTT_OFF || !rigCmd.ptt) qWarning() << "Amplifier fault, PTT off" << ampFault;
+    rigSet.ptt = RIG_PTT_OFF;
+    rigCmd.ptt = 1;
+    rigDaemon->requestPtt();
+    if (immediate && !scanActive) rigUpdate();    //PTT is the first command executed, do not wait for the timer
+
+    const QSignalBlocker blocker(ui->pushButton_PTT);
+    ui->pushButton_PTT->setChecked(false);
+}
+
+//* Doppler tracking, send the corrected frequencies only when the correction exceeds the step
+void MainWindow::dopplerUpdate()
+{
+    LagScope lag("MainWindow::dopplerUpdate");
+    double rangeRate, elevation;
+
+    if (!rigCom.connected || !doppler.compute(QDateTime::currentMSecsSinceEpoch(), &rangeRate, &elevation)) return;
+
+    freq_t down = qRound64(dopplerConf.downlink * (1.0 - rangeRate / 299792.458));   //Received frequency
+    freq_t up = qRound64(dopplerConf.uplink * (1.0 + rangeRate / 299792.458));   //Transmit frequency to hit the nominal uplink
+
+    if (dopplerConf.downlink && qAbs(down - dopplerDown) >= dopplerConf.step)
+    {
+        rigSet.freqMain = down;
+        rigCmd.freqMain = 1;
+        dopplerDown = down;
+    }
+
+    if (dopplerConf.uplink && rigSet.ptt == RIG_PTT_OFF && qAbs(up - dopplerUp) >= dopplerConf.step)  //Do not retune TX while transmitting
+    {
+        rigSet.freqSub = up;
+        rigCmd.freqSub = 1;
+        dopplerUp = up;
+    }
+
+    ui->statusbar->showMessage(QString("%1 El %2° Doppler %3 Hz").arg(doppler.satName).arg(elevation, 0, 'f', 1).arg(down - dopplerConf.downlink, 0, 'f', 0));
+}
+
+//* RigFollow handle results
+void MainWindow::on_rigFollowOpened(int retcode)
+{
+    if (retcode != RIG_OK)
+    {
+        QString followMsg = "Follow rig error: ";
+        followMsg.append(rigerror(retcode));
+        qWarning() << followMsg;
+        ui->statusbar->showMessage(followMsg);
+
+        const QSignalBlocker blocker(ui->action_Follow);
+        ui->action_Follow->setChecked(false);
+    }
+    else ui->statusbar->showMessage("Follow rig connected");
+}
+
+void MainWindow::on_rigFollowLagUpdated(int lag)
+{
+    ui->statusbar->showMessage(QString("Follow lag %1 ms").arg(lag), 2000);
+}
+
+//* Background rig session poll, queued on the session worker thread
+void MainWindow::sessionUpdate(int session)
+{
+    LagScope lag("MainWindow::sessionUpdate");
+    if (session == rigSessActive || !rigSess[session].com.connected || rigSess[session].rig == nullptr) return;
+    if (!sessPending[session].testAndSetOrdered(0, 1)) return;  //Previous poll still running, skip this tick
+
+    RIG *rig = rigSess[session].rig;
+    int fullPoll = rigSess[session].com.fullPoll;
+    QMetaObject::invokeMethod(sessDaemon[session], [session, rig, fullPoll]()
+    {
+        sessDaemon[session]->rigUpdate(rig, fullPoll);
+        sessPending[session].storeRelease(0);
+    }, Qt::QueuedConnection);
+}
+
+//* Open a standby session, parked and polled in background at pollBudget
+void MainWindow::sessionConnect(int session)
+{
+    if (session == rigSessActive || rigSess[session].com.connected || !rigSess[session].com.rigModel) return;
+
+    rigConnection &com = rigSess[session].com;
+    int retcode;
+
+    RIG *rig = sessDaemon[session]->rigConnect(com.rigModel, com.rigPort, com.serialSpeed, com.serialDataBits, com.serialParity, com.serialStopBits, com.serialHandshake, com.civAddr, com.autoPowerOn, &retcode);
+    if (retcode != RIG_OK)
+    {
+        qWarning() << "Standby" << com.profile << rigerror(retcode);
+        return;
+    }
+
+    if (rigSess[session].get.onoff != RIG_POWER_OFF)   //Double check if rig is on, as for the active session
+    {
+        freq_t retfreq;
+        retcode = tape_get_freq(rig, RIG_VFO_CURR, &retfreq);
+        rigSess[session].get.onoff = (retcode == RIG_OK && retfreq != 0) ? RIG_POWER_ON : RIG_POWER_OFF;
+    }
+
+    rigSess[session].rig = rig;
+    com.connected = 1;
+    sessTimer[session]->start(com.pollBudget);
+
+    qInfo() << "Standby" << com.profile << rig->state.model_name;
+}
+
+//* Switch the rig session bound to the GUI (SO2R)
+void MainWindow::setActiveSession(int session)
+{
+    LagScope lag("MainWindow::setActiveSession");
+    if (session == rigSessActive || session < 0 || session >= RIG_SESSION_MAX) return;
+
+    if ((rigCom.connected && rigSet.ptt != RIG_PTT_OFF) || scanActive || ui->action_BeaconMonitor->isChecked())  //Do not switch while transmitting or scanning
+    {
+        ui->statusbar->showMessage("Warning PTT on!");
+        sessAction[rigSessActive]->setChecked(true);    //Restore the menu selection
+        return;
+    }
+
+    QElapsedTimer switchTime;
+    switchTime.start();
+
+    int prev = rigSessActive;
+    timer->stop();
+
+    //Park the active session
+    rigSess[prev].rig = my_rig;
+    rigSess[prev].com = rigCom;
+    rigSess[prev].get = rigGet;
+    rigSess[prev].set = rigSet;
+    rigSess[prev].cmd = rigCmd;
+    rigSess[prev].cap = rigCap;
+    sessGuiCmd[prev] = guiCmd;
+    sessDaemon[prev]->setState(&rigSess[prev].get, &rigSess[prev].set, &rigSess[prev].cmd, &rigSess[prev].cap, &sessGuiCmd[prev]);
+
+    //Stop the background poll of the new session and wait for the running one
+    sessTimer[session]->stop();
+    QMetaObject::invokeMethod(sessDaemon[session], [](){}, Qt::BlockingQueuedConnection);
+
+    //Restore the new session into the GUI state
+    my_rig = rigSess[session].rig;
+    rigCom = rigSess[session].com;
+    rigGet = rigSess[session].get;
+    rigSet = rigSess[session].set;
+    rigCmd = rigSess[session].cmd;
+    rigCap = rigSess[session].cap;
+    guiCmd = sessGuiCmd[session];
+    sessDaemon[session]->setState(&rigGet, &rigSet, &rigCmd, &rigCap, &guiCmd);
+
+    rigDaemon = sessDaemon[session];
+    rigSessActive = session;
+    RigStats::setActive(&rigDaemon->stats);
+
+    if (rigSess[prev].com.connected) sessTimer[prev]->start(rigSess[prev].com.pollBudget);  //Keep polling the parked rig in background
+
+    if (command)    //Dialogs hold the previous rig handle
+    {
+        delete command;
+        command = nullptr;
+    }
+    if (radioInfo)
+    {
+        delete radioInfo;
+        radioInfo = nullptr;
+    }
+
+    {
+        const QSignalBlocker blocker(ui->pushButton_Connect);
+        ui->pushButton_Connect->setChecked(rigCom.connected);
+    }
+
+    if (rigCom.connected)
+    {
+        guiInit();
+        guiUpdate();
+        if (rigGet.onoff == RIG_POWER_ON) timer->start(rigCom.rigRefresh);
+    }
+
+    ui->statusbar->showMessage(QString("%1 active").arg(rigCom.profile));
+
+    qInfo() << "Rig session" << session+1 << rigCom.profile << switchTime.elapsed() << "ms";
 }
 
 //* SubMeter
@@ -1036,6 +1679,7 @@ bool MainWindow::checkHamlibVersion(int major, int minor, int revision)
 
 void MainWindow::on_pushButton_Connect_toggled(bool checked)
 {
+    LagScope lag("MainWindow::on_pushButton_Connect_toggled");
     qInfo() << "Connect" << checked;
 
     QString connectMsg;
@@ -1044,12 +1688,20 @@ void MainWindow::on_pushButton_Connect_toggled(bool checked)
     {
         int retcode;
 
-        if (netrigctl->isOpen)
+        //* Hamlib session recording or replay, [Tape] mode = off, record, replay
+        QSettings configFile(QString("catradio.ini"), QSettings::IniFormat);
+        QString tapeMode = configFile.value("Tape/mode", "off").toString();
+        QString tapeFile = configFile.value("Tape/file", "catradio.tape").toString();
+        unsigned rigModel = rigCom.rigModel;
+        if (tapeMode == "record") rigTape.record(tapeFile, rigModel);
+        else if (tapeMode == "replay" && rigTape.replay(tapeFile, configFile.value("Tape/speed", 1.0).toDouble())) rigModel = rigTape.model();  //Caps of the recorded rig
+
+        if (netrigctl->isOpen && rigSessActive == 0)    //rigctld serves only the first rig
         {
             QString rigPort = "127.0.0.1:" + QString::number(guiConf.rigctldPort);   //127.0.0.1:rigctldPort
             my_rig = rigDaemon->rigConnect(2, rigPort, rigCom.autoPowerOn, &retcode);
         }
-        else my_rig = rigDaemon->rigConnect(rigCom.rigModel, rigCom.rigPort, rigCom.serialSpeed, rigCom.serialDataBits, rigCom.serialParity, rigCom.serialStopBits, rigCom.serialHandshake, rigCom.civAddr, rigCom.autoPowerOn, &retcode);   //Open Rig connection
+        else my_rig = rigDaemon->rigConnect(rigModel, rigCom.rigPort, rigCom.serialSpeed, rigCom.serialDataBits, rigCom.serialParity, rigCom.serialStopBits, rigCom.serialHandshake, rigCom.civAddr, rigCom.autoPowerOn, &retcode);   //Open Rig connection
 
         if (retcode != RIG_OK)   //Connection error
         {
@@ -1057,6 +1709,7 @@ void MainWindow::on_pushButton_Connect_toggled(bool checked)
             connectMsg = "Connection error: ";
             connectMsg.append(rigerror(retcode));
             ui->pushButton_Connect->setChecked(false);  //Uncheck the button
+            rigTape.close();
 
             qCritical() << connectMsg;
         }
@@ -1069,7 +1722,7 @@ void MainWindow::on_pushButton_Connect_toggled(bool checked)
             if (rigCap.onoff == 0 || rigGet.onoff == RIG_POWER_ON || rigGet.onoff == RIG_POWER_UNKNOWN)
             {
                 freq_t retfreq;
-                retcode = rig_get_freq(my_rig, RIG_VFO_CURR, &retfreq); //double check if rig is on, by getting the current frequency
+                retcode = tape_get_freq(my_rig, RIG_VFO_CURR, &retfreq); //double check if rig is on, by getting the current frequency
                 if (retcode==RIG_OK && retfreq!=0)
                 {
                     rigGet.onoff = RIG_POWER_ON;    //force it for rigCap.onoff = 0 || rigGet.onoff = RIG_POWER_UNKNOWN
@@ -1102,11 +1755,19 @@ void MainWindow::on_pushButton_Connect_toggled(bool checked)
     {
         if (rigCom.connected)   //Close RIG
         {
-            if (rigSet.ptt == RIG_PTT_OFF)  //Disconnect only if PTT off
+            if (scanActive) //The scan or survey loop is using the rig handle on the worker thread
+            {
+                const QSignalBlocker blocker(ui->pushButton_Connect);
+                ui->pushButton_Connect->setChecked(true);
+                connectMsg = "Stop the scan first";
+            }
+            else if (rigSet.ptt == RIG_PTT_OFF)  //Disconnect only if PTT off
             {
+                if (ui->action_BeaconMonitor->isChecked()) ui->action_BeaconMonitor->setChecked(false);  //Stop the scheduler before closing
                 rigCom.connected = 0;
                 if(timer->isActive()) timer->stop();
                 rig_close(my_rig);  //Close the communication to the rig
+                if (rigTape.rig() == my_rig) rigTape.close();   //The tape belongs to the rig it was started with
                 connectMsg = "Disconnected";
 
                 //Reset meters
@@ -1136,7 +1797,7 @@ void MainWindow::on_pushButton_Power_toggled(bool checked)
 
     if (checked && !rigGet.onoff)
     {
-        retcode = rig_set_powerstat(my_rig, RIG_POWER_ON);
+        retcode = tape_set_powerstat(my_rig, RIG_POWER_ON);
         if (retcode != RIG_OK)
         {
             ui->pushButton_Power->setChecked(false);  //Uncheck the button
@@ -1157,15 +1818,24 @@ void MainWindow::on_pushButton_Power_toggled(bool checked)
 
 void MainWindow::on_pushButton_PTT_toggled(bool checked)
 {
-    if (checked)
+    if (checked && !ampFault.isEmpty())    //TX interlock, do not key into a faulted amplifier
+    {
+        const QSignalBlocker blocker(ui->pushButton_PTT);
+        ui->pushButton_PTT->setChecked(false);
+        ui->statusbar->showMessage("Amplifier fault: " + ampFault);
+    }
+    else if (checked)
     {
         rigSet.ptt = RIG_PTT_ON;
         rigCmd.ptt = 1;
+        rigDaemon->requestPtt();
+        ampDaemon->setTx(true); //Amplifier fast poll for the TX interlock
     }
     else    //!checked
     {
         rigSet.ptt = RIG_PTT_OFF;
         rigCmd.ptt = 1;
+        rigDaemon->requestPtt();
     }
 }
 
@@ -2020,16 +2690,19 @@ void MainWindow::on_horizontalSlider_clar_sliderReleased()
 
 void MainWindow::on_action_Connection_triggered()
 {
+    LagScope lag("MainWindow::on_action_Connection_triggered");
     qInfo() << "DialogConfig";
     DialogConfig config;
     config.setModal(true);
     config.exec();
 
     if (netrigctl) netrigctl->setRigctldArguments(rigCom.rigModel, rigCom.rigPort, rigCom.serialSpeed, rigCom.civAddr, guiConf.rigctldPort);
+    sessAction[rigSessActive]->setText(rigCom.profile);
 }
 
 void MainWindow::on_action_Setup_triggered()
 {
+    LagScope lag("MainWindow::on_action_Setup_triggered");
     qInfo() << "DialogSetup";
     DialogSetup setup;
     setup.setModal(true);
@@ -2075,14 +2748,49 @@ void MainWindow::on_actionCW_Keyer_triggered()
 
 void MainWindow::on_action_RadioInfo_triggered()
 {
+    LagScope lag("MainWindow::on_action_RadioInfo_triggered");
     qInfo() << "DialogRadioInfo";
     if (!radioInfo) radioInfo = new DialogRadioInfo(my_rig, this);
     radioInfo->setModal(true);
     radioInfo->exec();
 }
 
+void MainWindow::on_action_Stats_triggered()
+{
+    LagScope lag("MainWindow::on_action_Stats_triggered");
+    qInfo() << "DialogStats";
+    if (!stats) stats = new DialogStats(this);
+    stats->setModal(false);
+    stats->show();
+    stats->raise();
+    stats->activateWindow();
+}
+
+//* Trace recording, saved as Chrome trace event JSON when stopped
+void MainWindow::on_action_Trace_toggled(bool checked)
+{
+    if (checked)
+    {
+        rigTrace.start();
+        ui->statusbar->showMessage("Trace recording", 2000);
+    }
+    else
+    {
+        rigTrace.stop();
+        QString traceFileName = "trace-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".json";
+        if (rigTrace.save(traceFileName)) ui->statusbar->showMessage("Trace saved to " + traceFileName, 5000);
+        else ui->statusbar->showMessage("Unable to save trace", 5000);
+    }
+}
+
+void MainWindow::on_action_FlightRecorder_triggered()
+{
+    ui->statusbar->showMessage("Hamlib log saved to " + flightRecorder.dump("on demand"), 5000);
+}
+
 void MainWindow::on_action_Command_triggered()
 {
+    LagScope lag("MainWindow::on_action_Command_triggered");
     qInfo() << "DialogCommand";
     //DialogCommand command;
     //command.setModal(true);
@@ -2098,6 +2806,34 @@ void MainWindow::on_action_Command_triggered()
     command->activateWindow();
 }
 
+void MainWindow::on_action_Rotator_triggered()
+{
+    qInfo() << "DialogRotator";
+
+    if (!rotator)
+    {
+        rotator = new DialogRotator(rotDaemon, this);
+    }
+    rotator->setModal(false);
+    rotator->show();
+    rotator->raise();
+    rotator->activateWindow();
+}
+
+void MainWindow::on_action_Amplifier_triggered()
+{
+    qInfo() << "DialogAmplifier";
+
+    if (!amplifier)
+    {
+        amplifier = new DialogAmplifier(ampDaemon, this);
+    }
+    amplifier->setModal(false);
+    amplifier->show();
+    amplifier->raise();
+    amplifier->activateWindow();
+}
+
 void MainWindow::on_actionNET_rigctl_triggered()
 {
     qInfo() << "DialogNetRigctl";
@@ -2111,6 +2847,236 @@ void MainWindow::on_actionNET_rigctl_triggered()
     else qCritical() << "netrigctl not allocated";
 }
 
+void MainWindow::on_action_Follow_toggled(bool checked)
+{
+    qInfo() << "Follow" << checked;
+
+    if (checked)
+    {
+        rigFollowConfig conf = followConf;
+        QMetaObject::invokeMethod(rigFollow, [conf]()
+        {
+            rigFollow->open(conf.rigModel, conf.rigPort, conf.serialSpeed, conf.offset, conf.followMode);
+        }, Qt::QueuedConnection);
+    }
+    else
+    {
+        QMetaObject::invokeMethod(rigFollow, [](){ rigFollow->close(); }, Qt::QueuedConnection);
+        ui->statusbar->showMessage("Follow rig disconnected");
+    }
+}
+
+void MainWindow::on_action_Doppler_toggled(bool checked)
+{
+    qInfo() << "Doppler" << checked;
+
+    if (checked)
+    {
+        loadDopplerConfig("catradio.ini");
+        if (!doppler.loadTle(dopplerConf.tleFile, dopplerConf.satName))
+        {
+            ui->statusbar->showMessage("Doppler: unable to load " + dopplerConf.satName + " from " + dopplerConf.tleFile);
+            const QSignalBlocker blocker(ui->action_Doppler);
+            ui->action_Doppler->setChecked(false);
+            return;
+        }
+        doppler.setQth(dopplerConf.latitude, dopplerConf.longitude, dopplerConf.altitude);
+
+        dopplerDown = 0;
+        dopplerUp = 0;
+
+        if (dopplerConf.uplink && rigGet.split == RIG_SPLIT_OFF)    //Uplink on the sub VFO
+        {
+            rigSet.split = RIG_SPLIT_ON;
+            rigCmd.split = 1;
+        }
+
+        dopplerTimer->start(1000 / dopplerConf.rate);
+    }
+    else
+    {
+        dopplerTimer->stop();
+        ui->statusbar->showMessage("Doppler off");
+    }
+}
+
+void MainWindow::on_action_Scan_toggled(bool checked)
+{
+    qInfo() << "Scan" << checked;
+
+    if (checked)
+    {
+        if (!rigCom.connected || rigGet.ptt == RIG_PTT_ON || scanActive || ui->action_BeaconMonitor->isChecked())  //The scan loop would starve the scheduler on the same thread
+        {
+            const QSignalBlocker blocker(ui->action_Scan);
+            ui->action_Scan->setChecked(false);
+            if (ui->action_BeaconMonitor->isChecked()) ui->statusbar->showMessage("Scan: stop the beacon monitor first");
+            return;
+        }
+
+        loadScanConfig("catradio.ini");
+
+        timer->stop();  //The scan loop owns the rig until it ends
+        scanActive = true;
+
+        RIG *rig = my_rig;
+        RigDaemon *daemon = rigDaemon;
+        scanConfig scan = scanConf;
+        QMetaObject::invokeMethod(daemon, [daemon, rig, scan](){ daemon->scanRun(rig, scan); }, Qt::QueuedConnection);
+    }
+    else rigDaemon->scanStop();    //scanFinished restarts the polling
+}
+
+//* Beacon monitor, log the S-meter peak of each beacon slot
+void MainWindow::on_rigDaemonScheduleFired(QString tag, int type, double freq, int value, int strength, qint64 utc, double lateness, int retcode)
+{
+    if (retcode == RIG_OK && sender() == rigDaemon) //Apply the result to the active session state, the scheduler runs on the worker thread
+    {
+        if (type == RIG_EVENT_FREQ) rigGet.freqMain = rigSet.freqMain = freq;
+        else if (type == RIG_EVENT_PTT) rigGet.ptt = rigSet.ptt = value ? RIG_PTT_ON : RIG_PTT_OFF;
+        else if (type == RIG_EVENT_STRENGTH) rigGet.sMeter.i = strength;
+    }
+
+    if (type == RIG_EVENT_FREQ)
+    {
+        if (!beaconTag.isEmpty() && beaconLog.isOpen())  //Previous slot done
+        {
+            QTextStream out(&beaconLog);
+            out << QDateTime::fromMSecsSinceEpoch(beaconUtc, Qt::UTC).toString("yyyy-MM-dd hh:mm:ss") << "," << qint64(beaconFreq) << "," << beaconTag << "," << beaconPeak << Qt::endl;
+        }
+
+        beaconTag = tag;
+        beaconFreq = freq;
+        beaconUtc = utc;
+        beaconPeak = -54;
+    }
+    else if (type == RIG_EVENT_STRENGTH && retcode == RIG_OK && strength > beaconPeak) beaconPeak = strength;
+
+    ui->statusbar->showMessage(QString("Beacon %1 %2 kHz  %3 dB  late %4 ms").arg(tag).arg(freq/1000, 0, 'f', 0).arg(beaconPeak).arg(lateness, 0, 'f', 0));
+}
+
+void MainWindow::on_rigDaemonScheduleEmpty()
+{
+    if (!ui->action_BeaconMonitor->isChecked()) return;
+
+    QList<rigEvent> events = beacon_preset(QDateTime::currentMSecsSinceEpoch(), 60);   //Next 10 minutes
+    RigDaemon *daemon = rigDaemon;
+    QMetaObject::invokeMethod(daemon, [daemon, events](){ daemon->scheduleAdd(events); }, Qt::QueuedConnection);
+}
+
+void MainWindow::on_action_BeaconMonitor_toggled(bool checked)
+{
+    qInfo() << "Beacon monitor" << checked;
+
+    RigDaemon *daemon = rigDaemon;
+
+    if (checked)
+    {
+        if (!rigCom.connected || scanActive)
+        {
+            const QSignalBlocker blocker(ui->action_BeaconMonitor);
+            ui->action_BeaconMonitor->setChecked(false);
+            return;
+        }
+
+        beaconLog.setFileName("beacon.log");
+        beaconLog.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+        beaconTag.clear();
+
+        RIG *rig = my_rig;
+        QMetaObject::invokeMethod(daemon, [daemon, rig](){ daemon->scheduleStart(rig); }, Qt::QueuedConnection);  //Empty schedule, the preset is loaded on scheduleEmpty
+    }
+    else
+    {
+        QMetaObject::invokeMethod(daemon, [daemon](){ daemon->scheduleStop(); }, Qt::BlockingQueuedConnection);  //Wait for a pending event to complete, no scan or memory loop can be running
+        beaconLog.close();
+        ui->statusbar->showMessage("Beacon monitor off");
+    }
+}
+
+//* Macro, one batch in the daemon
+void MainWindow::runMacro(int index)
+{
+    if (!rigCom.connected || scanActive || index >= macroConf.size()) return;
+
+    RIG *rig = my_rig;
+    RigDaemon *daemon = rigDaemon;
+    rigMacro macro = macroConf.at(index);
+    QMetaObject::invokeMethod(daemon, [daemon, rig, macro](){ daemon->macroRun(rig, macro.name, macro.steps); }, Qt::QueuedConnection);
+}
+
+void MainWindow::on_rigDaemonMacroDone(QString name, QStringList results)
+{
+    int ok = results.count("OK");
+    for (int i = 0; i < results.size(); i++) if (results.at(i) != "OK") qWarning() << "Macro" << name << "step" << i+1 << results.at(i);
+
+    ui->statusbar->showMessage(QString("Macro %1: %2/%3 OK").arg(name).arg(ok).arg(results.size()), 5000);
+}
+
+//* Band survey, runs like the scan
+void MainWindow::on_surveyStart(scanConfig scan, int interval)
+{
+    if (!rigCom.connected || rigGet.ptt == RIG_PTT_ON || scanActive || ui->action_BeaconMonitor->isChecked())
+    {
+        ui->statusbar->showMessage(ui->action_BeaconMonitor->isChecked() ? "Survey: stop the beacon monitor first" : "Survey: rig not ready");
+        survey->on_surveyFinished();
+        return;
+    }
+
+    timer->stop();
+    scanActive = true;
+
+    RIG *rig = my_rig;
+    RigDaemon *daemon = rigDaemon;
+    QMetaObject::invokeMethod(daemon, [daemon, rig, scan, interval](){ daemon->surveyRun(rig, scan, interval, &surveyFile); }, Qt::QueuedConnection);
+}
+
+void MainWindow::on_action_Survey_triggered()
+{
+    LagScope lag("MainWindow::on_action_Survey_triggered");
+    qInfo() << "DialogSurvey";
+
+    if (!survey)
+    {
+        survey = new DialogSurvey(&surveyFile, this);
+        connect(survey, &DialogSurvey::surveyStart, this, &MainWindow::on_surveyStart);
+        connect(survey, &DialogSurvey::surveyStop, this, [](){ rigDaemon->scanStop(); });
+        for (int n = 0; n < RIG_SESSION_MAX; n++) connect(sessDaemon[n], &RigDaemon::surveyRow, survey, &DialogSurvey::on_surveyRow);
+    }
+    survey->setModal(false);
+    survey->show();
+    survey->raise();
+    survey->activateWindow();
+}
+
+void MainWindow::on_action_Memory_triggered()
+{
+    LagScope lag("MainWindow::on_action_Memory_triggered");
+    qInfo() << "DialogMemory";
+
+    if (!rigCom.connected || scanActive) return;
+    if (ui->action_BeaconMonitor->isChecked())  //Memory jobs run on the scheduler thread
+    {
+        ui->statusbar->showMessage("Memory: stop the beacon monitor first");
+        return;
+    }
+
+    RIG *rig = my_rig;
+    RigDaemon *daemon = rigDaemon;
+
+    DialogMemory memory(rig, &memoryBuffer, this);
+    connect(&memory, &DialogMemory::memoryRead, this, [daemon, rig](QList<int> channels, QList<rigChannel> *result){
+        QMetaObject::invokeMethod(daemon, [daemon, rig, channels, result](){ daemon->memoryRead(rig, channels, result); }, Qt::QueuedConnection); });
+    connect(&memory, &DialogMemory::memoryWrite, this, [daemon, rig](QList<rigChannel> channels){
+        QMetaObject::invokeMethod(daemon, [daemon, rig, channels](){ daemon->memoryWrite(rig, channels); }, Qt::QueuedConnection); });
+    connect(&memory, &DialogMemory::memoryStop, this, [daemon](){ daemon->scanStop(); });
+    connect(daemon, &RigDaemon::memoryProgress, &memory, &DialogMemory::on_memoryProgress);
+    connect(daemon, &RigDaemon::memoryDone, &memory, &DialogMemory::on_memoryDone);
+    memory.setModal(true);
+    memory.exec();
+}
+
+
 void MainWindow::on_action_AboutCatRadio_triggered()
 {
     QMessageBox msgBox;
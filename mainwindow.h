@@ -32,6 +32,7 @@
 #include <QSettings>
 
 #include "rig.h"
+#include "rigdata.h"
 #include "winkeyer.h"
 
 #define RELEASE_DATE __DATE__
@@ -57,6 +58,16 @@ public slots:
     void guiUpdate();
     void rigUpdate();   //Slot for QTimer
     void on_rigDaemonResultReady();    //Slot for rigDaemon resultReady
+    void on_rigFollowOpened(int retcode);   //Slot for rigFollow opened
+    void on_rigFollowLagUpdated(int lag);   //Slot for rigFollow lagUpdated
+    void dopplerUpdate();   //Slot for dopplerTimer
+    void on_ampFaultChanged(QString fault); //Slot for ampDaemon faultChanged
+    void on_rigDaemonScanStatus(double freq, int strength, double rate, bool hold);    //Slot for rigDaemon scanStatus
+    void on_rigDaemonScanFinished();   //Slot for rigDaemon scanFinished
+    void on_surveyStart(scanConfig scan, int interval);    //Slot for DialogSurvey surveyStart
+    void on_rigDaemonScheduleFired(QString tag, int type, double freq, int value, int strength, qint64 utc, double lateness, int retcode);    //Slot for rigDaemon scheduleFired
+    void on_rigDaemonScheduleEmpty();  //Slot for rigDaemon scheduleEmpty
+    void on_rigDaemonMacroDone(QString name, QStringList results);    //Slot for rigDaemon macroDone
     void on_vfoDisplayMainValueChanged(int value); //Slot for vfoDisplay Main valueChanged
     void on_vfoDisplaySubValueChanged(int value); //Slot for vfoDisplay Sub valueChanged
     void on_voiceKeyerStateChanged();
@@ -165,15 +176,27 @@ private slots:
     void on_action_AboutHamLib_triggered();
     void on_action_Command_triggered();
     void on_action_RadioInfo_triggered();
+    void on_action_Stats_triggered();
+    void on_action_Trace_toggled(bool checked);
+    void on_action_FlightRecorder_triggered();
     void on_action_AboutDarkTheme_triggered();
     void on_actionNET_rigctl_triggered();
+    void on_action_Rotator_triggered();
+    void on_action_Amplifier_triggered();
     void on_action_Voice_Keyer_triggered();
     void on_actionCW_Keyer_triggered();
     void on_action_AboutCatRadio_triggered();
+    void on_action_Follow_toggled(bool checked);
+    void on_action_Doppler_toggled(bool checked);
+    void on_action_Scan_toggled(bool checked);
+    void on_action_Survey_triggered();
+    void on_action_BeaconMonitor_toggled(bool checked);
+    void on_action_Memory_triggered();
 
 private:
     Ui::MainWindow *ui;
     QTimer *timer;
+    QTimer *dopplerTimer;
 
     QMediaPlayer *audioPlayer;
     QAudioOutput *audioOutput;
@@ -190,11 +213,25 @@ private:
     void guiInit();
 
     void loadGuiConfig(QString configFileName);
-    void loadRigConfig(QString configFileName);
+    void loadRigConfig(QString configFileName, rigConnection *rigConn, QString group = "");
     void audioOutputInit(QString configFileName);
     void loadCwKeyerConfig(QString configFileName);
+    void loadFollowConfig(QString configFileName);
+    void loadDopplerConfig(QString configFileName);
+    void loadRotatorConfig(QString configFileName);
+    void loadAmplifierConfig(QString configFileName);
+    void loadScanConfig(QString configFileName);
+    void loadMacroConfig(QString configFileName);
+    void loadMetricsConfig(QString configFileName);
+    void loadLagMonitorConfig(QString configFileName);
 
     void setSubMeter();
+    void ampTxInterlock(bool immediate);
+
+    void setActiveSession(int session);    //Switch the rig session bound to the GUI
+    void sessionUpdate(int session);   //Poll a background rig session
+    void sessionConnect(int session);  //Open a standby rig session
+    void runMacro(int index);
 
     bool checkHamlibVersion(int major, int minor, int revision);
 };
@@ -24,6 +24,7 @@
 #include <rig.h>    //Hamlib
 
 #include <QDebug>
+#include <QRegularExpression>
 
 extern rigSettings rigGet;
 extern rigSettings rigSet;
@@ -197,3 +198,126 @@ unsigned long long levelmeterstr (QString meterString)
     else levelMeter = RIG_METER_NONE;
     return levelMeter;
 }
+
+//* NCDXF/IARU beacon monitor preset
+//* 18 beacons on 5 bands, 10 s slots, 3 minutes cycle starting at 00:00:00 UTC.
+//* The rig hops band every slot, the S-meter is read every second during the slot.
+QList<rigEvent> beacon_preset (qint64 fromUtc, int slots)
+{
+    static const char *beaconCall[18] = {"4U1UN", "VE8AT", "W6WX", "KH6RS", "ZL6B", "VK6RBP", "JA2IGY", "RR9O", "VR2B",
+                                         "4S7B", "ZS6DN", "5Z4B", "4X6TU", "OH2B", "CS3B", "LU4AA", "OA4B", "YV5B"};
+    static const freq_t beaconFreq[5] = {14100000, 18110000, 21150000, 24930000, 28200000};
+
+    QList<rigEvent> events;
+    qint64 slot = fromUtc / 10000 + 1;  //Next slot
+
+    for (int i = 0; i < slots; i++, slot++)
+    {
+        int band = slot % 5;
+        int beacon = ((slot % 18) - band + 18) % 18;   //Beacon on this band in this slot
+
+        rigEvent event;
+        event.utc = slot * 10000;
+        event.type = RIG_EVENT_FREQ;
+        event.freq = beaconFreq[band];
+        event.value = 0;
+        event.tag = beaconCall[beacon];
+        events.append(event);
+
+        event.type = RIG_EVENT_STRENGTH;
+        for (int t = 1; t < 10; t++)
+        {
+            event.utc = slot * 10000 + t * 1000;
+            events.append(event);
+        }
+    }
+
+    return events;
+}
+
+//* Parse a macro script, steps separated by ';' or ','
+//* e.g. "freq 14.074; mode USB-D; bw 2.7k; agc fast; power 30"
+QList<rigMacroStep> macro_parse (QString script, QString *error)
+{
+    QList<rigMacroStep> steps;
+    const QStringList lines = script.split(QRegularExpression("[;,\\n]"), Qt::SkipEmptyParts);
+
+    for (const QString &line : lines)
+    {
+        QStringList word = line.simplified().split(' ');
+        if (word.at(0).isEmpty()) continue;
+
+        QString cmd = word.at(0).toLower();
+        QString arg = word.size() > 1 ? word.at(1).toUpper() : "";
+        bool ok = !arg.isEmpty();
+
+        rigMacroStep step = {};
+
+        if (cmd == "freq" || cmd == "txfreq")
+        {
+            step.cmd = (cmd == "freq") ? RIG_MACRO_FREQ : RIG_MACRO_TXFREQ;
+            step.freq = arg.toDouble(&ok);
+            if (arg.contains('.')) step.freq = step.freq * 1000000;   //MHz
+            ok = ok && step.freq >= 1000;  //Hz without a dot, "freq 7" is a typo and not 7 Hz
+        }
+        else if (cmd == "mode")
+        {
+            step.cmd = RIG_MACRO_MODE;
+            if (arg.endsWith("-D")) arg = "PKT" + arg.left(arg.size() - 2);    //USB-D = PKTUSB
+            step.mode = rig_parse_mode(arg.toLatin1());
+            ok = ok && step.mode != RIG_MODE_NONE;
+        }
+        else if (cmd == "bw")
+        {
+            step.cmd = RIG_MACRO_BW;
+            double k = arg.endsWith('K') ? 1000 : 1;
+            if (k > 1) arg.chop(1);
+            step.value = qRound(arg.toDouble(&ok) * k);
+        }
+        else if (cmd == "agc")
+        {
+            step.cmd = RIG_MACRO_AGC;
+            step.level = valueagclevel(levelagcstr(arg));
+            ok = ok && (arg == "AUTO" || levelagcstr(arg) != RIG_AGC_AUTO);  //levelagcstr falls back to AUTO
+        }
+        else if (cmd == "power")
+        {
+            step.cmd = RIG_MACRO_POWER;
+            step.level.f = arg.toFloat(&ok) / 100;
+            ok = ok && step.level.f >= 0 && step.level.f <= 1;
+        }
+        else if (cmd == "att" || cmd == "pre")
+        {
+            step.cmd = (cmd == "att") ? RIG_MACRO_ATT : RIG_MACRO_PRE;
+            step.level.i = arg.toInt(&ok);
+        }
+        else if (cmd == "split")
+        {
+            step.cmd = RIG_MACRO_SPLIT;
+            step.value = (arg == "ON") ? RIG_SPLIT_ON : RIG_SPLIT_OFF;
+            ok = (arg == "ON" || arg == "OFF");
+        }
+        else if (cmd == "ant")
+        {
+            step.cmd = RIG_MACRO_ANT;
+            step.value = antstr(arg);
+            ok = ok && (arg == "UNK" || antstr(arg) != RIG_ANT_UNKNOWN);  //antstr falls back to UNK
+        }
+        else if (cmd == "wait")
+        {
+            step.cmd = RIG_MACRO_WAIT;
+            step.value = qBound(0, arg.toInt(&ok), 2000);
+        }
+        else ok = false;
+
+        if (!ok)
+        {
+            if (error) *error = QString("Invalid step \"%1\"").arg(line.simplified());
+            return QList<rigMacroStep>();
+        }
+        steps.append(step);
+    }
+
+    if (error) error->clear();
+    return steps;
+}
@@ -23,9 +23,12 @@
 #endif // RIGCOMMAND_H
 
 #include <QString>
+#include <QList>
 
 #include <rig.h>
 
+#include "rigdata.h"
+
 
 void set_band (int band);
 void quick_split ();
@@ -36,3 +39,5 @@ agc_level_e levelagcstr (QString agcString);
 value_t valueagclevel (agc_level_e agcLevel);
 ant_t antstr (QString antString);
 unsigned long long levelmeterstr (QString meterString);
+QList<rigEvent> beacon_preset (qint64 fromUtc, int slots);
+QList<rigMacroStep> macro_parse (QString script, QString *error);
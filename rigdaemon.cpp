@@ -21,12 +21,19 @@
 #include "rigdata.h"
 #include "guidata.h"
 #include "rigcommand.h"
+#include "rigtape.h"
+#include "rigstats.h"
+#include "rigtrace.h"
 
 #include <QThread>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QVector>
 #include <QDebug>
 #include <QMessageBox>
 
 #include <rig.h>
+#include <cstring>
 
 //extern rigConnection rigCom;
 extern rigSettings rigGet;
@@ -36,17 +43,124 @@ extern rigCommand rigCap;
 extern guiConfig guiConf;
 extern guiCommand guiCmd;
 
-int indexCmd = 0;
-
 
 RigDaemon::RigDaemon(QObject *parent) : QObject(parent)
 {
+    setState(&::rigGet, &::rigSet, &::rigCmd, &::rigCap, &::guiCmd);    //Active session by default
+
+    monoClock.start();
+    deadlineMono = 0;
+    leadFreq = 20;
+    linkSet = linkRead = 0;
+}
+
+void RigDaemon::setState(rigSettings *get, rigSettings *set, rigCommand *cmd, rigCommand *cap, guiCommand *gcmd)
+{
+    stateGet = get;
+    stateSet = set;
+    stateCmd = cmd;
+    stateCap = cap;
+    stateGuiCmd = gcmd;
+    indexCmd = 0;   //Update all
+}
+
+//* Change mask, what the GUI has to refresh since it last asked
+quint64 RigDaemon::takeChanges()
+{
+    return changeMask.fetchAndStoreRelaxed(0);
+}
+
+void RigDaemon::markAllChanged()
+{
+    changeMask.storeRelaxed(RIG_CHANGED_ALL);
+}
+
+static inline bool valueChanged(const value_t &a, const value_t &b)
+{
+    return a.i != b.i;  //Same bits for .f
+}
 
+//* Fields to refresh for the commands executed, the widget shows the user input even if the rig rejected or ignored it
+static quint64 commandChanges(const rigCommand &before, const rigCommand &after)
+{
+    quint64 mask = 0;
+
+    if (before.onoff && !after.onoff) mask |= RIG_CHANGED_POWER;
+    if (before.freqMain && !after.freqMain) mask |= RIG_CHANGED_FREQ_MAIN;
+    if (before.freqSub && !after.freqSub) mask |= RIG_CHANGED_FREQ_SUB;
+    if ((before.vfoXchange && !after.vfoXchange) || (before.vfoCopy && !after.vfoCopy)) mask |= RIG_CHANGED_VFO | RIG_CHANGED_FREQ_MAIN | RIG_CHANGED_FREQ_SUB;
+    if ((before.vfoDown && !after.vfoDown) || (before.vfoUp && !after.vfoUp)) mask |= RIG_CHANGED_VFO | RIG_CHANGED_FREQ_MAIN | RIG_CHANGED_FREQ_SUB;
+    if ((before.bandUp && !after.bandUp) || (before.bandDown && !after.bandDown) || (before.bandChange && !after.bandChange)) mask |= RIG_CHANGED_FREQ_MAIN | RIG_CHANGED_MODE;
+    if (before.mode && !after.mode) mask |= RIG_CHANGED_MODE;
+    if (before.modeSub && !after.modeSub) mask |= RIG_CHANGED_MODE_SUB;
+    if (before.bwidth && !after.bwidth) mask |= RIG_CHANGED_BW;
+    if (before.split && !after.split) mask |= RIG_CHANGED_SPLIT;
+    if (before.ptt && !after.ptt) mask |= RIG_CHANGED_PTT;
+    if ((before.tuner && !after.tuner) || (before.tune && !after.tune)) mask |= RIG_CHANGED_TUNER;
+    if (before.agc && !after.agc) mask |= RIG_CHANGED_AGC;
+    if (before.att && !after.att) mask |= RIG_CHANGED_ATT;
+    if (before.pre && !after.pre) mask |= RIG_CHANGED_PRE;
+    if (before.rfPower && !after.rfPower) mask |= RIG_CHANGED_RF_POWER;
+    if (before.rfGain && !after.rfGain) mask |= RIG_CHANGED_RF_GAIN;
+    if (before.afGain && !after.afGain) mask |= RIG_CHANGED_AF_GAIN;
+    if (before.squelch && !after.squelch) mask |= RIG_CHANGED_SQUELCH;
+    if ((before.micGain && !after.micGain) || (before.micComp && !after.micComp) || (before.micMon && !after.micMon) || (before.micMonLevel && !after.micMonLevel) || (before.micCompLevel && !after.micCompLevel)) mask |= RIG_CHANGED_MIC;
+    if ((before.noiseBlanker && !after.noiseBlanker) || (before.noiseBlanker2 && !after.noiseBlanker2)) mask |= RIG_CHANGED_NB;
+    if ((before.noiseReduction && !after.noiseReduction) || (before.noiseReductionLevel && !after.noiseReductionLevel)) mask |= RIG_CHANGED_NR;
+    if (before.notchFilter && !after.notchFilter) mask |= RIG_CHANGED_NF;
+    if (before.ifShift && !after.ifShift) mask |= RIG_CHANGED_IF_SHIFT;
+    if (before.clar && !after.clar) mask |= RIG_CHANGED_CLAR;
+    if ((before.bkin && !after.bkin) || (before.apf && !after.apf) || (before.wpm && !after.wpm)) mask |= RIG_CHANGED_CW;
+    if ((before.rptShift && !after.rptShift) || (before.rptOffset && !after.rptOffset)) mask |= RIG_CHANGED_RPT;
+    if (before.tone && !after.tone) mask |= RIG_CHANGED_TONE;
+
+    return mask;
 }
 
+void RigDaemon::publishChanges()
+{
+    const rigSettings &rigGet = *stateGet;
+    const rigSettings &old = published;
+    quint64 mask = 0;
+
+    if (rigGet.onoff != old.onoff) mask |= RIG_CHANGED_POWER;
+    if (rigGet.freqMain != old.freqMain) mask |= RIG_CHANGED_FREQ_MAIN;
+    if (rigGet.freqSub != old.freqSub) mask |= RIG_CHANGED_FREQ_SUB;
+    if (rigGet.vfoMain != old.vfoMain || rigGet.vfoSub != old.vfoSub || rigGet.vfoTx != old.vfoTx) mask |= RIG_CHANGED_VFO;
+    if (rigGet.mode != old.mode) mask |= RIG_CHANGED_MODE;
+    if (rigGet.modeSub != old.modeSub) mask |= RIG_CHANGED_MODE_SUB;
+    if (rigGet.bwidth != old.bwidth || rigGet.bwNarrow != old.bwNarrow) mask |= RIG_CHANGED_BW;
+    if (rigGet.split != old.split) mask |= RIG_CHANGED_SPLIT;
+    if (rigGet.ptt != old.ptt) mask |= RIG_CHANGED_PTT;
+    if (valueChanged(rigGet.sMeter, old.sMeter) || valueChanged(rigGet.powerMeter, old.powerMeter) || valueChanged(rigGet.subMeter, old.subMeter) || valueChanged(rigGet.hiSWR, old.hiSWR)) mask |= RIG_CHANGED_METER;
+    if (rigGet.tuner != old.tuner) mask |= RIG_CHANGED_TUNER;
+    if (rigGet.agc != old.agc) mask |= RIG_CHANGED_AGC;
+    if (rigGet.att != old.att) mask |= RIG_CHANGED_ATT;
+    if (rigGet.pre != old.pre) mask |= RIG_CHANGED_PRE;
+    if (rigGet.rfPower != old.rfPower) mask |= RIG_CHANGED_RF_POWER;
+    if (rigGet.rfGain != old.rfGain) mask |= RIG_CHANGED_RF_GAIN;
+    if (rigGet.afGain != old.afGain) mask |= RIG_CHANGED_AF_GAIN;
+    if (rigGet.squelch != old.squelch) mask |= RIG_CHANGED_SQUELCH;
+    if (rigGet.micGain != old.micGain || rigGet.micComp != old.micComp || rigGet.micMon != old.micMon || rigGet.micMonLevel != old.micMonLevel || rigGet.micCompLevel != old.micCompLevel) mask |= RIG_CHANGED_MIC;
+    if (rigGet.noiseBlanker != old.noiseBlanker || rigGet.noiseBlanker2 != old.noiseBlanker2) mask |= RIG_CHANGED_NB;
+    if (rigGet.noiseReduction != old.noiseReduction || rigGet.noiseReductionLevel != old.noiseReductionLevel) mask |= RIG_CHANGED_NR;
+    if (rigGet.notchFilter != old.notchFilter) mask |= RIG_CHANGED_NF;
+    if (rigGet.ifShift != old.ifShift) mask |= RIG_CHANGED_IF_SHIFT;
+    if (rigGet.clar != old.clar || rigGet.rit != old.rit || rigGet.xit != old.xit || rigGet.ritOffset != old.ritOffset || rigGet.xitOffset != old.xitOffset) mask |= RIG_CHANGED_CLAR;
+    if (rigGet.bkin != old.bkin || rigGet.apf != old.apf || rigGet.wpm != old.wpm) mask |= RIG_CHANGED_CW;
+    if (rigGet.rptShift != old.rptShift || rigGet.rptOffset != old.rptOffset) mask |= RIG_CHANGED_RPT;
+    if (rigGet.toneType != old.toneType || rigGet.tone != old.tone) mask |= RIG_CHANGED_TONE;
+
+    published = rigGet;
+    if (mask) changeMask.fetchAndOrRelaxed(mask);
+}
+
+
 RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, unsigned serialSpeed, unsigned serialDataBits, unsigned serialParity, unsigned serialStopBits, unsigned serialHandshake, int civAddr, bool autoPowerOn, int *retcode)
 {
+    rigSettings &rigGet = *stateGet;
     RIG *my_rig = rig_init(rigModel); //Allocate rig handle
+    if (my_rig) stats.attach(my_rig);
 
     if (!my_rig)    //Wrong Rig number
     {
@@ -91,13 +205,13 @@ RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, unsigned serialSp
 
         if (autoPowerOn) my_rig->state.auto_power_on = 1;
 
-        *retcode = rig_open(my_rig);
+        *retcode = tape_open(my_rig);
 
         if (*retcode != RIG_OK) return nullptr;  //Rig not connected
         else    //Rig connected
         {
-            if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_POWERSTAT)) rig_get_powerstat(my_rig, &rigGet.onoff);
-            if (my_rig->caps->get_powerstat != NULL) rig_get_powerstat(my_rig, &rigGet.onoff);
+            if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_POWERSTAT)) tape_get_powerstat(my_rig, &rigGet.onoff);
+            if (my_rig->caps->get_powerstat != NULL) tape_get_powerstat(my_rig, &rigGet.onoff);
             else rigGet.onoff = RIG_POWER_UNKNOWN;
             return my_rig;
         }
@@ -107,7 +221,9 @@ RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, unsigned serialSp
 
 RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, bool autoPowerOn, int *retcode)
 {
+    rigSettings &rigGet = *stateGet;
     RIG *my_rig = rig_init(rigModel); //Allocate rig handle
+    if (my_rig) stats.attach(my_rig);
 
     if (!my_rig)    //Wrong Rig number
     {
@@ -131,13 +247,13 @@ RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, bool autoPowerOn,
     }
     if (autoPowerOn) my_rig->state.auto_power_on = 1;
 
-    *retcode = rig_open(my_rig);
+    *retcode = tape_open(my_rig);
 
     if (*retcode != RIG_OK) return nullptr;  //Rig not connected
     else    //Rig connected
     {
-        if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_POWERSTAT)) rig_get_powerstat(my_rig, &rigGet.onoff);
-        if (my_rig->caps->get_powerstat != NULL) rig_get_powerstat(my_rig, &rigGet.onoff);
+        if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_POWERSTAT)) tape_get_powerstat(my_rig, &rigGet.onoff);
+        if (my_rig->caps->get_powerstat != NULL) tape_get_powerstat(my_rig, &rigGet.onoff);
         else rigGet.onoff = RIG_POWER_UNKNOWN;
         return my_rig;
     }
@@ -146,6 +262,24 @@ RIG *RigDaemon::rigConnect(unsigned rigModel, QString rigPort, bool autoPowerOn,
 
 void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
 {
+    //Session state store, shadows the globals so that a background session polls its own copy
+    rigSettings &rigGet = *stateGet;
+    rigSettings &rigSet = *stateSet;
+    rigCommand &rigCmd = *stateCmd;
+    rigCommand &rigCap = *stateCap;
+    guiCommand &guiCmd = *stateGuiCmd;
+
+    if (scheduleBusy.loadAcquire()) return; //Timed event imminent, skip this poll
+    QMutexLocker rigLocker(&rigMutex);
+    TraceScope trace("rig", "rigUpdate");
+
+    qint64 pollStart = stats.now();
+    int queue = 0;  //Pending commands, rigCommand is all int flags
+    const int *flag = reinterpret_cast<const int *>(&rigCmd);
+    for (unsigned i = 0; i < sizeof(rigCommand) / sizeof(int); i++) if (flag[i]) queue++;
+    rigTrace.counter("queue", queue);
+    const rigCommand pending = rigCmd;  //Commands consumed by this poll are re-synced on the GUI
+
     int retcode;
     value_t retvalue;
 
@@ -153,16 +287,17 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
     //* PTT
     if (rigCmd.ptt)
     {
-        retcode = rig_set_ptt(my_rig, RIG_VFO_CURR, rigSet.ptt);
+        retcode = tape_set_ptt(my_rig, RIG_VFO_CURR, rigSet.ptt);
         if (retcode == RIG_OK) rigGet.ptt = rigSet.ptt;
         rigCmd.ptt = 0;
+        pttRequest.storeRelease(0);
     }
 
     //* CW memory keyer (rig)
     if (guiConf.cwKeyerMode == 0 && rigCmd.cwSend && (rigGet.mode == RIG_MODE_CW || rigGet.mode == RIG_MODE_CWN || rigGet.mode == RIG_MODE_CWR))
     {
         //if (rig_has_get_func(my_rig, RIG_FUNCTION_SEND_MORSE)) rig_send_morse(my_rig, RIG_VFO_CURR, &rigSet.cwMem);
-        retcode = rig_send_morse(my_rig, RIG_VFO_CURR, &rigSet.cwMem);
+        retcode = tape_send_morse(my_rig, RIG_VFO_CURR, &rigSet.cwMem);
         if (retcode == RIG_OK) rigGet.ptt = RIG_PTT_ON; //assume PPT on if send_morse is ok
         rigCmd.cwSend = 0;
     }
@@ -170,7 +305,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
     //* Voice memory keyer (rig)
     if (guiConf.voiceKeyerMode == 0 && rigCmd.voiceSend && (rigGet.mode == RIG_MODE_SSB || rigGet.mode == RIG_MODE_USB || rigGet.mode == RIG_MODE_LSB || rigGet.mode == RIG_MODE_AM || rigGet.mode == RIG_MODE_FM))
     {
-        retcode = rig_send_voice_mem(my_rig, RIG_VFO_CURR, rigSet.voiceMem);
+        retcode = tape_send_voice_mem(my_rig, RIG_VFO_CURR, rigSet.voiceMem);
         if (retcode == RIG_OK) rigGet.ptt = RIG_PTT_ON; //assume PPT on if send_voice_mem is ok
         rigCmd.voiceSend = 0;
     }
@@ -178,7 +313,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
     //* VFO
     if (rigCmd.freqMain)   //VFO Main
     {
-        retcode = rig_set_freq(my_rig, RIG_VFO_CURR, rigSet.freqMain);
+        retcode = tape_set_freq(my_rig, RIG_VFO_CURR, rigSet.freqMain);
         if (retcode == RIG_OK) rigGet.freqMain = rigSet.freqMain;
         rigCmd.freqMain = 0;
         guiCmd.rangeList = 1;
@@ -186,7 +321,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
 
     else if (rigCmd.freqSub && rigCap.freqSub)   //VFO Sub
     {
-        retcode = rig_set_freq(my_rig, rigGet.vfoSub, rigSet.freqSub);
+        retcode = tape_set_freq(my_rig, rigGet.vfoSub, rigSet.freqSub);
         if (retcode == RIG_OK) rigGet.freqSub = rigSet.freqSub;
         rigCmd.freqSub = 0;
     }
@@ -196,44 +331,45 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
     {
         //* PTT
         ptt_t retptt;
-        retcode = rig_get_ptt(my_rig, RIG_VFO_CURR, &retptt);
+        retcode = tape_get_ptt(my_rig, RIG_VFO_CURR, &retptt);
         if (retcode == RIG_OK) rigGet.ptt = retptt;
 
         //* VFO
         freq_t retfreq;
-        retcode = rig_get_freq(my_rig, RIG_VFO_CURR, &retfreq); //get VFO Main
+        retcode = tape_get_freq(my_rig, RIG_VFO_CURR, &retfreq); //get VFO Main
         if (retcode == RIG_OK) rigGet.freqMain = retfreq;
         if (rigCap.freqSub)   //get sub VFO freq if targetable
         {
-            retcode = rig_get_freq(my_rig, rigGet.vfoSub, &retfreq);
+            retcode = tape_get_freq(my_rig, rigGet.vfoSub, &retfreq);
             if (retcode == RIG_OK) rigGet.freqSub = retfreq;
         }
 
         //* Meter
         if (rigGet.ptt == 1 || rigSet.ptt == 1)
         {
-            rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER_METER, &rigGet.powerMeter);
-            if (rigSet.meter != RIG_METER_NONE) rig_get_level(my_rig, RIG_VFO_CURR, rigSet.meter, &rigGet.subMeter);
+            tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER_METER, &rigGet.powerMeter);
+            if (rigSet.meter != RIG_METER_NONE) tape_get_level(my_rig, RIG_VFO_CURR, rigSet.meter, &rigGet.subMeter);
 
             if (rig_has_get_level(my_rig, RIG_METER_SWR) && (rigSet.meter != RIG_LEVEL_SWR))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SWR, &rigGet.hiSWR);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SWR, &rigGet.hiSWR);
             }
             else if (rigSet.meter == RIG_LEVEL_SWR) rigGet.hiSWR = rigGet.subMeter;
         }
         else
         {
-            retcode = rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, &retvalue);
+            retcode = tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, &retvalue);
             if (retcode == RIG_OK) rigGet.sMeter = retvalue;
         }
 
         //***** Command execution *****
+        qint64 traceCommand = rigTrace.now();
         if (!rigGet.ptt && !rigSet.ptt)
         {
             //* Power off
             if (rigCmd.onoff && rigCap.onoff)
             {
-                retcode = rig_set_powerstat(my_rig, RIG_POWER_OFF);
+                retcode = tape_set_powerstat(my_rig, RIG_POWER_OFF);
                 if (retcode == RIG_OK) rigGet.onoff = RIG_POWER_OFF;
             }
             rigCmd.onoff = 0;
@@ -241,7 +377,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* Mode
             if (rigCmd.mode && rigSet.mode != RIG_MODE_NONE)    //VFO Main
             {
-                retcode = rig_set_mode(my_rig, RIG_VFO_CURR, rigSet.mode, RIG_PASSBAND_NOCHANGE);
+                retcode = tape_set_mode(my_rig, RIG_VFO_CURR, rigSet.mode, RIG_PASSBAND_NOCHANGE);
                 if (retcode == RIG_OK)
                 {
                     guiCmd.bwidthList = 1;  //Command update of BW list
@@ -254,7 +390,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             }
             if (rigCmd.modeSub && rigCap.modeSub && rigSet.modeSub != RIG_MODE_NONE)  //VFO Sub
             {
-                retcode = rig_set_mode(my_rig, rigGet.vfoSub, rigSet.mode, RIG_PASSBAND_NOCHANGE);
+                retcode = tape_set_mode(my_rig, rigGet.vfoSub, rigSet.mode, RIG_PASSBAND_NOCHANGE);
                 if (retcode == RIG_OK)
                 {
                 }
@@ -264,7 +400,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* BandWidth
             if (rigCmd.bwidth)
             {
-                retcode = rig_set_mode(my_rig, RIG_VFO_CURR, rigGet.mode, rigSet.bwidth);
+                retcode = tape_set_mode(my_rig, RIG_VFO_CURR, rigGet.mode, rigSet.bwidth);
                 if (retcode == RIG_OK) rigGet.bwidth = rigSet.bwidth;
                 rigCmd.bwidth = 0;
             }
@@ -273,15 +409,15 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.split)
             {
                 freq_t tempFreq = rigGet.freqMain;  //temporary save for non targettable sub VFO
-                if (rigSet.split) retcode = rig_set_split_vfo(my_rig, rigGet.vfoMain, rigSet.split, rigGet.vfoSub); //Split on
-                else retcode = rig_set_split_vfo(my_rig, rigGet.vfoMain, rigSet.split, rigGet.vfoMain); //Split off
+                if (rigSet.split) retcode = tape_set_split_vfo(my_rig, rigGet.vfoMain, rigSet.split, rigGet.vfoSub); //Split on
+                else retcode = tape_set_split_vfo(my_rig, rigGet.vfoMain, rigSet.split, rigGet.vfoMain); //Split off
                 //retcode = rig_set_split_vfo(my_rig, RIG_VFO_RX, rigSet.split, RIG_VFO_TX);
                 if (retcode == RIG_OK)
                 {
                     rigGet.split = rigSet.split;
                     if (rigGet.split && (my_rig->caps->targetable_vfo & RIG_TARGETABLE_FREQ) == 0)    //if non targettable sub VFO
                     {
-                        rig_get_freq(my_rig, RIG_VFO_CURR, &retfreq);
+                        tape_get_freq(my_rig, RIG_VFO_CURR, &retfreq);
                         if (retfreq != tempFreq) rigGet.freqSub = tempFreq; //in this case VFOs were toggled, so print out the right sub VFO frequency
                     }
                 }
@@ -295,7 +431,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 //if (my_rig->caps->vfo_ops & RIG_OP_XCHG)
                 {
                     mode_t tempMode = rigGet.mode;
-                    retcode = rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_XCHG);
+                    retcode = tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_XCHG);
                     if (retcode == RIG_OK)
                     {
                         if (rigCap.modeSub == 0) rigGet.modeSub = tempMode; //If mode sub VFO not targettable, use buffer
@@ -309,7 +445,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 {
                     freq_t tempFreq = rigGet.freqMain;
                     mode_t tempMode = rigGet.mode;
-                    retcode = rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_TOGGLE);
+                    retcode = tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_TOGGLE);
                     if (retcode == RIG_OK)
                     {
                         if (rigCap.freqSub == 0) rigGet.freqSub = tempFreq; //If freq sub VFO not targettable, use buffer
@@ -327,7 +463,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (my_rig->state.vfo_ops & RIG_OP_CPY)
                 //if (my_rig->caps->vfo_ops & RIG_OP_CPY)
                 {
-                    retcode = rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_CPY);
+                    retcode = tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_CPY);
                     if (retcode == RIG_OK)
                     {
                         if (rigCap.freqSub == 0) rigGet.freqSub = rigGet.freqMain;
@@ -340,14 +476,14 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* VFO Down
             if (rigCmd.vfoDown)
             {
-                rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_DOWN);
+                tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_DOWN);
                 rigCmd.vfoDown = 0;
             }
 
             //* VFO Up
             if (rigCmd.vfoUp)
             {
-                rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_UP);
+                tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_UP);
                 rigCmd.vfoUp = 0;
             }
 
@@ -357,7 +493,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (my_rig->state.vfo_ops & RIG_OP_BAND_UP)
                 //if (my_rig->caps->vfo_ops & RIG_OP_BAND_UP)
                 {
-                    retcode = rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_BAND_UP);
+                    retcode = tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_BAND_UP);
                     if (retcode == RIG_OK) indexCmd = 21;
                 }
                 rigCmd.bandUp = 0;
@@ -369,7 +505,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (my_rig->state.vfo_ops & RIG_OP_BAND_DOWN)
                 //if (my_rig->caps->vfo_ops & RIG_OP_BAND_DOWN)
                 {
-                    retcode = rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_BAND_DOWN);
+                    retcode = tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_BAND_DOWN);
                     if (retcode == RIG_OK) indexCmd = 21;
                 }
                 rigCmd.bandDown = 0;
@@ -381,7 +517,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (rigCap.bandChange)
                 {
                     retvalue.i = rigSet.band;
-                    retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_BAND_SELECT, retvalue);
+                    retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_BAND_SELECT, retvalue);
                     if (retcode == RIG_OK)
                     {
                         rigGet.band = rigSet.band;
@@ -394,7 +530,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* Tune
             if (rigCmd.tune)
             {
-                if (my_rig->state.vfo_ops & RIG_OP_TUNE) rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_TUNE);
+                if (my_rig->state.vfo_ops & RIG_OP_TUNE) tape_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_TUNE);
                 //if (my_rig->caps->vfo_ops & RIG_OP_TUNE) rig_vfo_op(my_rig, RIG_VFO_CURR, RIG_OP_TUNE);
                 rigCmd.tune = 0;
             }
@@ -402,7 +538,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* Antenna
             if (rigCmd.ant)
             {
-                retcode = rig_set_ant(my_rig, RIG_VFO_CURR, rigSet.ant, retvalue);
+                retcode = tape_set_ant(my_rig, RIG_VFO_CURR, rigSet.ant, retvalue);
                 if (retcode == RIG_OK) rigGet.ant = rigSet.ant;
                 rigCmd.ant = 0;
             }
@@ -410,7 +546,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* AGC
             if (rigCmd.agc)
             {
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AGC, valueagclevel(rigSet.agc));
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AGC, valueagclevel(rigSet.agc));
                 if (retcode == RIG_OK) rigGet.agc = rigSet.agc;
                 rigCmd.agc = 0;
             }
@@ -419,7 +555,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.att)
             {
                 retvalue.i = rigSet.att;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_ATT, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_ATT, retvalue);
                 if (retcode == RIG_OK) rigGet.att = rigSet.att;
                 rigCmd.att = 0;
             }
@@ -428,7 +564,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.pre)
             {
                 retvalue.i = rigSet.pre;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_PREAMP, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_PREAMP, retvalue);
                 if (retcode == RIG_OK) rigGet.pre = rigSet.pre;
                 rigCmd.pre = 0;
             }
@@ -437,7 +573,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.rfGain)
             {
                 retvalue.f = rigSet.rfGain;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RF, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RF, retvalue);
                 if (retcode == RIG_OK) rigGet.rfGain = rigSet.rfGain;
                 rigCmd.rfGain = 0;
             }
@@ -446,7 +582,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.afGain)
             {
                 retvalue.f = rigSet.afGain;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AF, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AF, retvalue);
                 if (retcode == RIG_OK) rigGet.afGain = rigSet.afGain;
                 rigCmd.afGain = 0;
             }
@@ -455,7 +591,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.squelch)
             {
                 retvalue.f = rigSet.squelch;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SQL, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SQL, retvalue);
                 if (retcode == RIG_OK) rigGet.squelch = rigSet.squelch;
                 rigCmd.squelch = 0;
             }
@@ -464,7 +600,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.micGain)
             {
                 retvalue.f = rigSet.micGain;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MICGAIN, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MICGAIN, retvalue);
                 if (retcode == RIG_OK) rigGet.micGain = rigSet.micGain;
                 rigCmd.micGain = 0;
             }
@@ -473,13 +609,13 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.micCompLevel)
             {
                 retvalue.f = rigSet.micCompLevel;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_COMP, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_COMP, retvalue);
                 if (retcode == RIG_OK) rigGet.micCompLevel = rigSet.micCompLevel;
                 rigCmd.micCompLevel = 0;
             }
             if (rigCmd.micComp)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_COMP, rigSet.micComp);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_COMP, rigSet.micComp);
                 if (retcode == RIG_OK) rigGet.micComp = rigSet.micComp;
                 rigCmd.micComp = 0;
             }
@@ -488,13 +624,13 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.micMonLevel)
             {
                 retvalue.f = rigSet.micMonLevel;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MONITOR_GAIN, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MONITOR_GAIN, retvalue);
                 if (retcode == RIG_OK) rigGet.micMonLevel = rigSet.micMonLevel;
                 rigCmd.micMonLevel = 0;
             }
             if (rigCmd.micMon)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_MON, rigSet.micMon);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_MON, rigSet.micMon);
                 if (retcode == RIG_OK) rigGet.micMon = rigSet.micMon;
                 rigCmd.micMon = 0;
             }
@@ -502,13 +638,13 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* NB noise blanker
             if (rigCmd.noiseBlanker)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB, rigSet.noiseBlanker);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB, rigSet.noiseBlanker);
                 if (retcode == RIG_OK) rigGet.noiseBlanker = rigSet.noiseBlanker;
                 rigCmd.noiseBlanker = 0;
             }
             if (rigCmd.noiseBlanker2)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB2, rigSet.noiseBlanker2);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB2, rigSet.noiseBlanker2);
                 if (retcode == RIG_OK) rigGet.noiseBlanker2 = rigSet.noiseBlanker2;
                 rigCmd.noiseBlanker2 = 0;
             }
@@ -516,7 +652,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* NR noise reduction
             if (rigCmd.noiseReduction)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NR, rigSet.noiseReduction);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NR, rigSet.noiseReduction);
                 if (retcode == RIG_OK) rigGet.noiseReduction = rigSet.noiseReduction;
                 rigCmd.noiseReduction = 0;
             }
@@ -524,7 +660,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.noiseReductionLevel)
             {
                 retvalue.f = rigSet.noiseReductionLevel;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_NR, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_NR, retvalue);
                 if (retcode == RIG_OK) rigGet.noiseReductionLevel = rigSet.noiseReductionLevel;
                 rigCmd.noiseReductionLevel = 0;
             }
@@ -532,7 +668,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* NF notch filter
             if (rigCmd.notchFilter)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_ANF, rigSet.notchFilter);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_ANF, rigSet.notchFilter);
                 if (retcode == RIG_OK) rigGet.notchFilter = rigSet.notchFilter;
                 rigCmd.notchFilter = 0;
             }
@@ -541,7 +677,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.ifShift)
             {
                 retvalue.i = rigSet.ifShift;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_IF, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_IF, retvalue);
                 if (retcode == RIG_OK) rigGet.ifShift = rigSet.ifShift;
                 rigCmd.ifShift = 0;
             }
@@ -551,8 +687,8 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             {
                 if (rigSet.clar != rigGet.clar)
                 {
-                    if (rigSet.rit) retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, rigSet.clar);
-                    else if (rigSet.xit) retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, rigSet.clar);
+                    if (rigSet.rit) retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, rigSet.clar);
+                    else if (rigSet.xit) retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, rigSet.clar);
                     if (retcode == RIG_OK)
                     {
                         rigGet.clar = rigSet.clar;
@@ -563,23 +699,23 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
 
                 if ((rigSet.rit != rigGet.rit) && rigGet.clar)
                 {
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, rigSet.rit);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, rigSet.rit);
                     if (retcode == RIG_OK) rigGet.rit = rigSet.rit;
                 }
                 if ((rigSet.xit != rigGet.xit) && rigGet.clar)
                 {
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, rigSet.xit);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, rigSet.xit);
                     if (retcode == RIG_OK) rigGet.xit = rigSet.xit;
                 }
 
                 if (rigSet.rit)
                 {
-                    retcode = rig_set_rit(my_rig, RIG_VFO_CURR, rigSet.ritOffset);
+                    retcode = tape_set_rit(my_rig, RIG_VFO_CURR, rigSet.ritOffset);
                     if (retcode == RIG_OK) rigGet.ritOffset = rigSet.ritOffset;
                 }
                 else if (rigSet.xit)
                 {
-                    retcode = rig_set_xit(my_rig, RIG_VFO_CURR, rigSet.xitOffset);
+                    retcode = tape_set_xit(my_rig, RIG_VFO_CURR, rigSet.xitOffset);
                     if (retcode == RIG_OK) rigGet.xitOffset = rigSet.xitOffset;
                 }
                 rigCmd.clar = 0;
@@ -589,14 +725,14 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             //* CW break-in
             if (rigCmd.bkin)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_FBKIN, rigSet.bkin);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_FBKIN, rigSet.bkin);
                 if (retcode == RIG_OK) rigGet.bkin = rigSet.bkin;
                 rigCmd.bkin = 0;
             }
             //* CW Auto Peak Filter
             if (rigCmd.apf)
             {
-                retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_APF, rigSet.apf);
+                retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_APF, rigSet.apf);
                 if (retcode == RIG_OK) rigGet.apf = rigSet.apf;
                 rigCmd.apf = 0;
             }
@@ -604,7 +740,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigCmd.wpm)
             {
                 retvalue.i = rigSet.wpm;
-                retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, retvalue);
+                retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, retvalue);
                 if (retcode == RIG_OK) rigGet.wpm = rigSet.wpm;
                 rigCmd.wpm = 0;
             }
@@ -616,7 +752,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (rig_has_set_func(my_rig, RIG_FUNCTION_SET_RPTR_SHIFT))
                 //if (my_rig->caps->set_rptr_shift)
                 {
-                    retcode = rig_set_rptr_shift(my_rig, RIG_VFO_CURR, rigSet.rptShift);
+                    retcode = tape_set_rptr_shift(my_rig, RIG_VFO_CURR, rigSet.rptShift);
                     if (retcode == RIG_OK) rigGet.rptShift = rigSet.rptShift;
                 }
                 rigCmd.rptShift = 0;
@@ -627,7 +763,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 if (rig_has_set_func(my_rig, RIG_FUNCTION_SET_RPTR_OFFS))
                 //if (my_rig->caps->set_rptr_offs)
                 {
-                    retcode = rig_set_rptr_offs(my_rig, RIG_VFO_CURR, rigSet.rptOffset);
+                    retcode = tape_set_rptr_offs(my_rig, RIG_VFO_CURR, rigSet.rptOffset);
                     if (retcode == RIG_OK) rigGet.rptOffset = rigSet.rptOffset;
                 }
                 rigCmd.rptOffset = 0;
@@ -638,28 +774,28 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
                 switch (rigSet.toneType)
                 {
                 case 1: //Burst 1750 Hz
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, true);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, true);
                     break;
                 case 2: //CTCSS tone
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, true);
-                    if (rigSet.tone) rig_set_ctcss_tone(my_rig, RIG_VFO_CURR, rigSet.tone);
-                    else rig_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigSet.tone);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, true);
+                    if (rigSet.tone) tape_set_ctcss_tone(my_rig, RIG_VFO_CURR, rigSet.tone);
+                    else tape_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigSet.tone);
                     break;
                 case 3: //CTCSS tone + squelch
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, true);
-                    if (rigSet.tone) rig_set_ctcss_tone(my_rig, RIG_VFO_CURR, rigSet.tone);
-                    else rig_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigSet.tone);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, true);
+                    if (rigSet.tone) tape_set_ctcss_tone(my_rig, RIG_VFO_CURR, rigSet.tone);
+                    else tape_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigSet.tone);
                     break;
                 case 4: //DCS tone + squelch
-                    retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, true);
-                    if (rigSet.tone) rig_set_dcs_code(my_rig, RIG_VFO_CURR, rigSet.tone);
-                    else rig_get_dcs_code(my_rig, RIG_VFO_CURR, &rigSet.tone);
+                    retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, true);
+                    if (rigSet.tone) tape_set_dcs_code(my_rig, RIG_VFO_CURR, rigSet.tone);
+                    else tape_get_dcs_code(my_rig, RIG_VFO_CURR, &rigSet.tone);
                     break;
                  default:
-                    rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, false);
-                    rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, false);
-                    rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, false);
-                    rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, false);
+                    tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, false);
+                    tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, false);
+                    tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, false);
+                    tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, false);
                     retcode = RIG_OK;
                     break;
                 }
@@ -677,7 +813,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         //* Tuner
         if (rigCmd.tuner)
         {
-            retcode = rig_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TUNER, rigSet.tuner);
+            retcode = tape_set_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TUNER, rigSet.tuner);
             if (retcode == RIG_OK) rigGet.tuner = rigSet.tuner;
             rigCmd.tune = 0;
         }
@@ -686,18 +822,20 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         if (rigCmd.rfPower)
         {
             retvalue.f = rigSet.rfPower;
-            retcode = rig_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, retvalue);
+            retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, retvalue);
             if (retcode == RIG_OK) rigGet.rfPower = rigSet.rfPower;
             rigCmd.rfPower = 0;
         }
 
+        rigTrace.add("rig", "commands", traceCommand, rigTrace.now() - traceCommand);
+
         //***** Poll execution *****
         //* Mode and BW
         if ((indexCmd == 1 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
             rmode_t tempMode;
 
-            rig_get_mode(my_rig, RIG_VFO_CURR, &tempMode, &rigGet.bwidth);
+            tape_get_mode(my_rig, RIG_VFO_CURR, &tempMode, &rigGet.bwidth);
 
             if (tempMode != rigGet.mode)
             {
@@ -711,24 +849,24 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
             if (rigGet.bwidth == rig_passband_narrow(my_rig, rigGet.mode)) rigGet.bwNarrow = 1;
             else rigGet.bwNarrow = 0;
 
-            if (rigCap.modeSub) rig_get_mode(my_rig, rigGet.vfoSub, &rigGet.modeSub, &rigGet.bwidthSub);
+            if (rigCap.modeSub) tape_get_mode(my_rig, rigGet.vfoSub, &rigGet.modeSub, &rigGet.bwidthSub);
         }
 
         //* VFO and Split
         if ((indexCmd == 2 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            rig_get_split_vfo(my_rig, RIG_VFO_CURR, &rigGet.split, &rigGet.vfoTx);            
+            tape_get_split_vfo(my_rig, RIG_VFO_CURR, &rigGet.split, &rigGet.vfoTx);            
 
-            rig_get_vfo(my_rig, &rigGet.vfoMain);
+            tape_get_vfo(my_rig, &rigGet.vfoMain);
         }
 
         //* Tuner
-        if ((indexCmd == 3 && !rigGet.ptt && fullPoll) || indexCmd == 0) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TUNER, &rigGet.tuner);
+        if ((indexCmd == 3 && !rigGet.ptt && fullPoll) || indexCmd == 0) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TUNER, &rigGet.tuner);
 
         //* Antenna
         if ((indexCmd == 4 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_ANT)) rig_get_ant(my_rig, RIG_VFO_CURR, RIG_ANT_CURR, &retvalue, &rigGet.ant, &rigGet.antTx, &rigGet.antRx);
+            if (rig_has_get_func(my_rig, RIG_FUNCTION_GET_ANT)) tape_get_ant(my_rig, RIG_VFO_CURR, RIG_ANT_CURR, &retvalue, &rigGet.ant, &rigGet.antTx, &rigGet.antRx);
         }
 
         //* AGC
@@ -736,7 +874,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_AGC))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AGC, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AGC, &retvalue);
                 rigGet.agc = levelagcvalue(retvalue.i);
             }
         }
@@ -746,7 +884,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_ATT))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_ATT, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_ATT, &retvalue);
                 rigGet.att = retvalue.i;
             }
         }
@@ -756,7 +894,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_PREAMP))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_PREAMP, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_PREAMP, &retvalue);
                 rigGet.pre = retvalue.i;
             }
         }
@@ -766,7 +904,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_RFPOWER))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, &retvalue);
                 rigGet.rfPower = retvalue.f;
             }
         }
@@ -776,7 +914,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_RF))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RF, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RF, &retvalue);
                 rigGet.rfGain = retvalue.f;
             }
         }
@@ -786,7 +924,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_AF))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AF, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AF, &retvalue);
                 rigGet.afGain = retvalue.f;
             }
         }
@@ -796,7 +934,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_SQL))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SQL, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_SQL, &retvalue);
                 rigGet.squelch = retvalue.f;
             }
         }
@@ -806,13 +944,13 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_MICGAIN))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MICGAIN, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MICGAIN, &retvalue);
                 rigGet.micGain = retvalue.f;
             }
-            if (rig_has_get_func(my_rig, RIG_FUNC_COMP)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_COMP, &rigGet.micComp);
+            if (rig_has_get_func(my_rig, RIG_FUNC_COMP)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_COMP, &rigGet.micComp);
             if (rig_has_get_level(my_rig, RIG_LEVEL_COMP))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_COMP, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_COMP, &retvalue);
                 rigGet.micCompLevel = retvalue.f;
             }
         }
@@ -820,10 +958,10 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         //* Monitor
         if ((indexCmd == 13 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_MON)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_MON, &rigGet.micMon);
+            if (rig_has_get_func(my_rig, RIG_FUNC_MON)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_MON, &rigGet.micMon);
             if (rig_has_get_level(my_rig, RIG_LEVEL_MONITOR_GAIN))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MONITOR_GAIN, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_MONITOR_GAIN, &retvalue);
                 rigGet.micMonLevel = retvalue.f;
             }
         }
@@ -831,17 +969,17 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         //* NB noise blanker
         if ((indexCmd == 14 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_NB)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB, &rigGet.noiseBlanker);
-            if (rig_has_get_func(my_rig, RIG_FUNC_NB2)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB2, &rigGet.noiseBlanker2);
+            if (rig_has_get_func(my_rig, RIG_FUNC_NB)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB, &rigGet.noiseBlanker);
+            if (rig_has_get_func(my_rig, RIG_FUNC_NB2)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NB2, &rigGet.noiseBlanker2);
         }
 
         //* NR noise reduction
         if ((indexCmd == 15 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_NR)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NR, &rigGet.noiseReduction);
+            if (rig_has_get_func(my_rig, RIG_FUNC_NR)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_NR, &rigGet.noiseReduction);
             if (rig_has_get_level(my_rig, RIG_LEVEL_NR))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_NR, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_NR, &retvalue);
                 rigGet.noiseReductionLevel = retvalue.f;
             }
         }
@@ -849,7 +987,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         //* NF notch filter
         if ((indexCmd == 16 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_ANF)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_ANF, &rigGet.notchFilter);
+            if (rig_has_get_func(my_rig, RIG_FUNC_ANF)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_ANF, &rigGet.notchFilter);
         }
 
         //* IF Shift
@@ -857,7 +995,7 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         {
             if (rig_has_get_level(my_rig, RIG_LEVEL_IF))
             {
-                rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_IF, &retvalue);
+                tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_IF, &retvalue);
                 rigGet.ifShift = retvalue.i;
             }
         }
@@ -865,56 +1003,56 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         //* Clarifier
         if ((indexCmd == 18 && !rigGet.ptt && fullPoll) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_RIT)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, &rigGet.rit);  //RIT
-            if (rig_has_get_func(my_rig, RIG_FUNC_XIT)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, &rigGet.xit);  //XIT
+            if (rig_has_get_func(my_rig, RIG_FUNC_RIT)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_RIT, &rigGet.rit);  //RIT
+            if (rig_has_get_func(my_rig, RIG_FUNC_XIT)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_XIT, &rigGet.xit);  //XIT
             rigGet.clar = rigGet.rit || rigGet.xit;
             //qDebug() << rigGet.clar << rigGet.rit << rigGet.xit;
-            if (rigSet.rit && my_rig->caps->get_rit) rig_get_rit(my_rig, RIG_VFO_CURR, &rigGet.ritOffset);
-            else if (rigSet.xit && my_rig->caps->get_xit) rig_get_xit(my_rig, RIG_VFO_CURR, &rigGet.xitOffset);
+            if (rigSet.rit && my_rig->caps->get_rit) tape_get_rit(my_rig, RIG_VFO_CURR, &rigGet.ritOffset);
+            else if (rigSet.xit && my_rig->caps->get_xit) tape_get_xit(my_rig, RIG_VFO_CURR, &rigGet.xitOffset);
             //else rigGet.clarOffset = rigSet.clarOffset;
         }
 
         //* CW
         if ((indexCmd == 19 && !rigGet.ptt && fullPoll && (rigGet.mode == RIG_MODE_CW || rigGet.mode == RIG_MODE_CWN || rigGet.mode == RIG_MODE_CWR)) || indexCmd == 0)
         {
-            if (rig_has_get_func(my_rig, RIG_FUNC_FBKIN)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_FBKIN, &rigGet.bkin);   //Break-in
-            if (rig_has_get_func(my_rig, RIG_FUNC_APF)) rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_APF, &rigGet.apf);      //Audio Peak Filter
-            if (guiConf.cwKeyerMode == 0 && rig_has_get_level(my_rig, RIG_LEVEL_KEYSPD)) rig_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, &retvalue);   //Keyer speed WPM
+            if (rig_has_get_func(my_rig, RIG_FUNC_FBKIN)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_FBKIN, &rigGet.bkin);   //Break-in
+            if (rig_has_get_func(my_rig, RIG_FUNC_APF)) tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_APF, &rigGet.apf);      //Audio Peak Filter
+            if (guiConf.cwKeyerMode == 0 && rig_has_get_level(my_rig, RIG_LEVEL_KEYSPD)) tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_KEYSPD, &retvalue);   //Keyer speed WPM
             rigGet.wpm = retvalue.i;
         }
 
         //* FM
         if ((indexCmd == 20 && !rigGet.ptt && fullPoll && (rigGet.mode == RIG_MODE_FM || rigGet.mode == RIG_MODE_WFM || rigGet.mode == RIG_MODE_FMN)) || indexCmd == 0)
         {
-            rig_get_rptr_shift(my_rig, RIG_VFO_CURR, &rigGet.rptShift);     //Repeater Shift
-            rig_get_rptr_offs(my_rig, RIG_VFO_CURR, &rigGet.rptOffset);     //Repeater Offset
+            tape_get_rptr_shift(my_rig, RIG_VFO_CURR, &rigGet.rptShift);     //Repeater Shift
+            tape_get_rptr_offs(my_rig, RIG_VFO_CURR, &rigGet.rptOffset);     //Repeater Offset
 
             int status = false;
             if (!(my_rig->caps->has_get_func & RIG_FUNC_TONE)) status = 1;   //If get cap is not available skip
             if (!status)
             {
-                rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, &status);   //1750 Hz Tone burst
+                tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TBURST, &status);   //1750 Hz Tone burst
                 if (status) rigGet.toneType = 1;
             }
             if (!status)
             {
-                rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, &status);     //CTCSS Tone Tx
+                tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TONE, &status);     //CTCSS Tone Tx
                 if (status) rigGet.toneType = 2;
             }
             if (!status)
             {
-                rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, &status);     //CTCSS Tone Tx and Rx Squelch
+                tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_TSQL, &status);     //CTCSS Tone Tx and Rx Squelch
                 if (status) rigGet.toneType = 3;
             }
             if (!status)
             {
-                rig_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, &status);     //DCS Code
+                tape_get_func(my_rig, RIG_VFO_CURR, RIG_FUNC_CSQL, &status);     //DCS Code
                 if (status) rigGet.toneType = 4;
             }
             if (!status) rigGet.toneType = 0;
 
-            if ((rigGet.toneType == 2 || rigGet.toneType == 3) && my_rig->caps->get_ctcss_tone) rig_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigGet.tone);
-            else if (rigGet.toneType == 4 && my_rig->caps->get_dcs_code) rig_get_dcs_code(my_rig, RIG_VFO_CURR, &rigGet.tone);
+            if ((rigGet.toneType == 2 || rigGet.toneType == 3) && my_rig->caps->get_ctcss_tone) tape_get_ctcss_tone(my_rig, RIG_VFO_CURR, &rigGet.tone);
+            else if (rigGet.toneType == 4 && my_rig->caps->get_dcs_code) tape_get_dcs_code(my_rig, RIG_VFO_CURR, &rigGet.tone);
 
             /*if (rigGet.toneType && rigGet.tone == 0)
             {
@@ -929,5 +1067,530 @@ void RigDaemon::rigUpdate(RIG *my_rig, bool fullPoll)
         if (indexCmd >= 21) indexCmd = 1;
     }
 
+    stats.poll(stats.now() - pollStart, queue);
+    stats.tx(rigGet.ptt == RIG_PTT_ON, rigGet.hiSWR.f);
+    changeMask.fetchAndOrRelaxed(commandChanges(pending, rigCmd));
+    publishChanges();
     emit resultReady();
 }
+
+
+//* Scanner fast path: tune, let the receiver settle for dwell (us) and read the signal strength
+//* The rig starts tuning when set_freq reaches it and samples STRENGTH when the read reaches it,
+//* so half of each measured round trip already counts as settle time and only the rest is slept
+bool RigDaemon::scanRead(RIG *my_rig, freq_t freq, int dwell, value_t *strength)
+{
+    QElapsedTimer link;
+    link.start();
+    if (tape_set_freq(my_rig, RIG_VFO_CURR, freq) != RIG_OK) return false;
+    qint64 setTime = link.nsecsElapsed() / 1000;
+    linkSet = linkSet > 0 ? 0.9 * linkSet + 0.1 * setTime : setTime;
+
+    qint64 wait = dwell - (setTime + qRound64(linkRead)) / 2;
+    if (wait > 0) QThread::usleep(wait);
+
+    link.restart();
+    if (tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, strength) != RIG_OK) return false;
+    qint64 readTime = link.nsecsElapsed() / 1000;
+    linkRead = linkRead > 0 ? 0.9 * linkRead + 0.1 * readTime : readTime;
+    return true;
+}
+
+//* Settle time already covered by the link, a shorter dwell would not scan any faster
+int RigDaemon::scanDwellMin()
+{
+    return qRound((linkSet + linkRead) / 2);
+}
+
+//* Scanner
+//* Step the channel list as fast as the link allows: set_freq, wait the dwell less the link time, read STRENGTH.
+//* A reading over the threshold is confirmed by a second read; a failed confirmation means
+//* the receiver had not settled, so the dwell is increased, while a run of clean channels
+//* slowly shortens it. On a confirmed signal the scan holds until it drops for the hang time.
+void RigDaemon::scanRun(RIG *my_rig, scanConfig scan)
+{
+    QList<freq_t> channel = scan.list;
+    if (channel.isEmpty() && scan.step > 0)
+    {
+        for (freq_t f = scan.start; f <= scan.stop; f += scan.step) channel.append(f);
+    }
+    if (channel.isEmpty())
+    {
+        emit scanFinished();
+        return;
+    }
+
+    scanAbort.storeRelease(0);
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 statusTime = 0;
+    int statusCount = 0;
+    double rate = 0;
+
+    int dwell = scan.dwell * 1000;  //us
+    int cleanCount = 0;
+    int index = 0;
+    freq_t freq = channel.at(0);
+    value_t strength;
+    strength.i = -54;
+
+    qInfo() << "Scan start" << channel.size() << "channels";
+
+    while (!scanAbort.loadAcquire() && !pttRequest.loadAcquire())   //PTT request ends the scan
+    {
+        freq = channel.at(index);
+        if (!scanRead(my_rig, freq, dwell, &strength)) break;
+        statusCount++;
+
+        if (strength.i >= scan.threshold)
+        {
+            QThread::usleep(dwell + 1000);
+            tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, &strength);
+
+            if (strength.i >= scan.threshold)   //Signal, hold
+            {
+                emit scanStatus(freq, strength.i, rate, true);
+
+                qint64 dropTime = -1;
+                while (!scanAbort.loadAcquire() && !pttRequest.loadAcquire())
+                {
+                    QThread::msleep(100);
+                    if (tape_get_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, &strength) != RIG_OK) break;
+
+                    if (strength.i >= scan.threshold) dropTime = -1;
+                    else if (dropTime < 0) dropTime = clock.elapsed();
+                    else if (clock.elapsed() - dropTime >= scan.hang) break;    //Resume after the hang time
+
+                    emit scanStatus(freq, strength.i, rate, true);
+                }
+
+                statusTime = clock.elapsed();
+                statusCount = 0;
+            }
+            else    //Not settled, longer dwell
+            {
+                dwell = qMin(dwell + dwell / 5 + 1000, scan.dwellMax * 1000);
+                cleanCount = 0;
+            }
+        }
+        else if (++cleanCount >= 50)    //Clean run, shorter dwell
+        {
+            dwell = qMax(dwell - dwell / 20, scanDwellMin());
+            cleanCount = 0;
+        }
+
+        if (clock.elapsed() - statusTime >= 250)
+        {
+            rate = statusCount * 1000.0 / (clock.elapsed() - statusTime);
+            statusTime = clock.elapsed();
+            statusCount = 0;
+            emit scanStatus(freq, strength.i, rate, false);
+        }
+
+        index = (index + 1) % channel.size();
+    }
+
+    qInfo() << "Scan stop" << freq << "dwell" << dwell << "us, link set" << qRound(linkSet) << "read" << qRound(linkRead) << "us";
+
+    emit scanStatus(freq, strength.i, rate, false); //Last channel, applied to rigGet on the GUI thread
+    emit scanFinished();
+}
+
+void RigDaemon::scanStop()
+{
+    scanAbort.storeRelease(1);
+}
+
+void RigDaemon::requestPtt()
+{
+    pttRequest.storeRelease(1);
+}
+
+
+//* Band survey
+//* Sweep the range with the scanner fast path and append one row per sweep to the survey file
+void RigDaemon::surveyRun(RIG *my_rig, scanConfig scan, int interval, SurveyFile *survey)
+{
+    int bins = survey->bins();
+    QVector<qint8> levels(bins);
+
+    scanAbort.storeRelease(0);
+
+    QElapsedTimer clock;
+    clock.start();
+
+    int dwell = scan.dwell * 1000;  //us
+    value_t strength;
+    int failed = 0; //Consecutive skipped bins
+    quint64 skipped = 0;
+
+    qInfo() << "Survey start" << bins << "bins";
+
+    while (!scanAbort.loadAcquire() && !pttRequest.loadAcquire())   //PTT request ends the survey
+    {
+        qint64 sweepStart = clock.elapsed();
+        qint64 sweepTime = QDateTime::currentMSecsSinceEpoch();
+
+        int bin;
+        for (bin = 0; bin < bins && !scanAbort.loadAcquire() && failed < SURVEY_ERRORS; bin++)
+        {
+            bool ok = false;
+            for (int retry = 0; retry < SURVEY_RETRIES && !ok; retry++) ok = scanRead(my_rig, scan.start + bin * scan.step, dwell, &strength);
+
+            if (ok)
+            {
+                levels[bin] = qBound(SURVEY_NO_LEVEL + 1, strength.i, 127);
+                failed = 0;
+            }
+            else    //Transient link error, skip the bin
+            {
+                levels[bin] = SURVEY_NO_LEVEL;
+                skipped++;
+                failed++;
+            }
+        }
+        if (bin < bins) break;  //Aborted or link lost, drop the partial sweep
+
+        survey->append(sweepTime, levels.constData());
+        emit surveyRow(survey->count(), clock.elapsed() - sweepStart);
+
+        while (!scanAbort.loadAcquire() && !pttRequest.loadAcquire() && clock.elapsed() - sweepStart < interval * 1000) QThread::msleep(50);
+    }
+
+    if (failed >= SURVEY_ERRORS) qWarning() << "Survey link lost," << failed << "bins failed in a row";
+    qInfo() << "Survey stop" << survey->count() << "rows" << skipped << "bins skipped";
+
+    emit scanFinished();
+}
+
+
+//* Timed command scheduler
+//* Events fire at UTC deadlines converted to the monotonic clock when armed. Frequency changes
+//* are sent ahead by the measured set_freq latency so that they land on time, and the poll is
+//* held off the rig shortly before each deadline. Lateness is measured when the command completes.
+void RigDaemon::scheduleStart(RIG *my_rig)
+{
+    scheduleRig = my_rig;
+
+    if (!scheduleTimer)
+    {
+        scheduleTimer = new QTimer(this);
+        scheduleTimer->setSingleShot(true);
+        scheduleTimer->setTimerType(Qt::PreciseTimer);
+        connect(scheduleTimer, &QTimer::timeout, this, &RigDaemon::scheduleFire);
+    }
+
+    scheduleArm();
+}
+
+void RigDaemon::scheduleStop()
+{
+    if (scheduleTimer) scheduleTimer->stop();
+    schedule.clear();
+    scheduleRig = nullptr;
+    scheduleBusy.storeRelease(0);
+}
+
+void RigDaemon::scheduleAdd(QList<rigEvent> events)
+{
+    for (const rigEvent &event : events)
+    {
+        int i = schedule.size();
+        while (i > 0 && schedule.at(i - 1).utc > event.utc) i--;
+        schedule.insert(i, event);
+    }
+
+    if (scheduleRig) scheduleArm();
+}
+
+void RigDaemon::scheduleArm()
+{
+    if (!scheduleRig || !scheduleTimer) return;
+
+    qint64 nowUtc = QDateTime::currentMSecsSinceEpoch();
+    qint64 nowMono = monoClock.elapsed();
+
+    while (!schedule.isEmpty() && schedule.first().utc < nowUtc - 1000)   //Missed by more than 1 s, drop
+    {
+        qWarning() << "Scheduled event missed" << schedule.first().tag;
+        schedule.removeFirst();
+    }
+
+    if (schedule.isEmpty())
+    {
+        scheduleBusy.storeRelease(0);
+        emit scheduleEmpty();
+        return;
+    }
+
+    const rigEvent &event = schedule.first();
+    deadlineMono = nowMono + (event.utc - nowUtc);
+    qint64 fireMono = deadlineMono - (event.type == RIG_EVENT_FREQ ? qRound64(leadFreq) : 0);
+    qint64 delay = fireMono - nowMono;
+
+    if (delay > 250)    //Wake up again close to the deadline, then hold the poll
+    {
+        scheduleBusy.storeRelease(0);
+        scheduleTimer->start(delay - 200);
+        return;
+    }
+
+    scheduleBusy.storeRelease(1);
+    scheduleTimer->start(qMax<qint64>(delay, 0));
+}
+
+void RigDaemon::scheduleFire()
+{
+    if (!scheduleRig || schedule.isEmpty()) return;
+
+    qint64 fireMono = deadlineMono - (schedule.first().type == RIG_EVENT_FREQ ? qRound64(leadFreq) : 0);
+    if (monoClock.elapsed() < fireMono - 2) //Early wake up
+    {
+        scheduleArm();
+        return;
+    }
+
+    rigEvent event = schedule.takeFirst();
+    value_t strength;
+    strength.i = 0;
+    int retcode = RIG_OK;
+
+    {
+        QMutexLocker rigLocker(&rigMutex);
+        qint64 start = monoClock.elapsed();
+
+        switch (event.type)
+        {
+        case RIG_EVENT_FREQ:
+            retcode = tape_set_freq(scheduleRig, RIG_VFO_CURR, event.freq);
+            if (retcode == RIG_OK) leadFreq = 0.8 * leadFreq + 0.2 * (monoClock.elapsed() - start);    //Latency estimate
+            break;
+        case RIG_EVENT_PTT:
+            retcode = tape_set_ptt(scheduleRig, RIG_VFO_CURR, event.value ? RIG_PTT_ON : RIG_PTT_OFF);
+            break;
+        case RIG_EVENT_STRENGTH:
+            retcode = tape_get_level(scheduleRig, RIG_VFO_CURR, RIG_LEVEL_STRENGTH, &strength);
+            break;
+        }
+    }
+
+    double lateness = monoClock.elapsed() - deadlineMono;
+    emit scheduleFired(event.tag, event.type, event.freq, event.value, strength.i, event.utc, lateness, retcode);   //The state store is updated by the receiver
+
+    scheduleArm();
+}
+
+
+//***** Memory channels *****
+
+//* Read the memory channels one by one, the poll can run in between
+void RigDaemon::memoryRead(RIG *my_rig, QList<int> channels, QList<rigChannel> *result)
+{
+    scanAbort.storeRelease(0);
+    result->clear();
+
+    int retcode = RIG_OK;
+    int firstError = RIG_OK;
+
+    qInfo() << "Memory read" << channels.size() << "channels";
+
+    for (int i = 0; i < channels.size() && !scanAbort.loadAcquire(); i++)
+    {
+        channel_t chan;
+        memset(&chan, 0, sizeof(chan));
+        chan.vfo = RIG_VFO_MEM;
+        chan.channel_num = channels.at(i);
+
+        {
+            QMutexLocker rigLocker(&rigMutex);
+            retcode = tape_get_channel(my_rig, RIG_VFO_MEM, &chan, 1);   //read_only, the rig is restored to the current VFO
+        }
+        if (retcode == -RIG_ENIMPL || retcode == -RIG_ENAVAIL || retcode == -RIG_EIO) break;
+
+        if (retcode == -RIG_ERJCTED || retcode == -RIG_EINVAL || (retcode == RIG_OK && chan.freq == 0))   //Blank channel, rejected by most rigs
+        {
+            rigChannel mem = {};
+            mem.num = channels.at(i);
+            mem.error = RIG_OK;
+            result->append(mem);
+            emit memoryProgress(i + 1, channels.size());
+            continue;
+        }
+
+        rigChannel mem;
+        mem.num = channels.at(i);
+        mem.freq = (retcode == RIG_OK) ? chan.freq : 0;
+        mem.mode = chan.mode;
+        mem.width = chan.width;
+        mem.txFreq = chan.tx_freq;
+        mem.split = chan.split;
+        mem.rptrShift = chan.rptr_shift;
+        mem.rptrOffs = chan.rptr_offs;
+        mem.ctcss = chan.ctcss_tone;
+        mem.name = QString::fromLatin1(chan.channel_desc, qstrnlen(chan.channel_desc, HAMLIB_MAXCHANDESC));
+        mem.error = retcode;
+        result->append(mem);
+
+        if (retcode != RIG_OK && firstError == RIG_OK) firstError = retcode;
+        emit memoryProgress(i + 1, channels.size());
+    }
+
+    if (retcode == RIG_OK || firstError != RIG_OK) retcode = firstError;   //Report the first channel error, or the one that stopped the read
+    qInfo() << "Memory read done" << result->size() << rigerror(retcode);
+    emit memoryDone(result->size(), retcode);
+}
+
+//* Program the memory channels, stop at the first error
+//* Each channel is read back first so that the fields not edited by the dialog (tones, steps, levels, flags) are kept,
+//* a channel with no frequency is written blank, which the backend takes as a memory clear
+void RigDaemon::memoryWrite(RIG *my_rig, QList<rigChannel> channels)
+{
+    scanAbort.storeRelease(0);
+
+    int retcode = RIG_OK;
+    int count = 0;
+
+    qInfo() << "Memory write" << channels.size() << "channels";
+
+    for (int i = 0; i < channels.size() && !scanAbort.loadAcquire(); i++)
+    {
+        const rigChannel &mem = channels.at(i);
+
+        channel_t chan;
+        memset(&chan, 0, sizeof(chan));
+        chan.vfo = RIG_VFO_MEM;
+        chan.channel_num = mem.num;
+
+        if (mem.freq == 0)  //Clear
+        {
+            QMutexLocker rigLocker(&rigMutex);
+            retcode = tape_set_channel(my_rig, RIG_VFO_MEM, &chan);
+        }
+        else
+        {
+            QMutexLocker rigLocker(&rigMutex);
+            if (tape_get_channel(my_rig, RIG_VFO_MEM, &chan, 1) != RIG_OK)  //Blank channel, start from scratch
+            {
+                memset(&chan, 0, sizeof(chan));
+                chan.vfo = RIG_VFO_MEM;
+                chan.channel_num = mem.num;
+                chan.tx_vfo = RIG_VFO_B;
+            }
+
+            chan.freq = mem.freq;
+            chan.mode = mem.mode;
+            chan.width = mem.width;
+            chan.split = mem.split;
+            if (mem.split == RIG_SPLIT_ON)
+            {
+                chan.tx_freq = mem.txFreq;
+                chan.tx_mode = mem.mode;
+                chan.tx_width = mem.width;
+            }
+            chan.rptr_shift = mem.rptrShift;
+            chan.rptr_offs = mem.rptrOffs;
+            chan.ctcss_tone = mem.ctcss;
+            memset(chan.channel_desc, 0, sizeof(chan.channel_desc));
+            strncpy(chan.channel_desc, mem.name.toLatin1().constData(), HAMLIB_MAXCHANDESC - 1);
+
+            retcode = tape_set_channel(my_rig, RIG_VFO_MEM, &chan);
+        }
+        if (retcode != RIG_OK) break;
+
+        count++;
+        emit memoryProgress(count, channels.size());
+    }
+
+    qInfo() << "Memory write done" << count << rigerror(retcode);
+    emit memoryDone(count, retcode);
+}
+
+
+//***** Macro *****
+
+//* Run the steps in order, holding the rig between waits, a stop or PTT request skips the remaining steps
+void RigDaemon::macroRun(RIG *my_rig, QString name, QList<rigMacroStep> steps)
+{
+    const rigSettings &rigGet = *stateGet;   //Read only, under rigMutex
+
+    QStringList results;
+    QElapsedTimer clock;
+    clock.start();
+
+    scanAbort.storeRelease(0);
+    int busy = scheduleBusy.fetchAndStoreOrdered(1);   //The poll skips instead of waiting on the mutex
+    QMutexLocker rigLocker(&rigMutex);
+
+    rmode_t mode = rigGet.mode;
+
+    for (const rigMacroStep &step : steps)
+    {
+        if (scanAbort.loadAcquire() || pttRequest.loadAcquire())
+        {
+            results.append("Aborted");
+            continue;
+        }
+
+        int retcode = RIG_OK;
+        value_t retvalue;
+
+        switch (step.cmd)
+        {
+        case RIG_MACRO_FREQ:
+            retcode = tape_set_freq(my_rig, RIG_VFO_CURR, step.freq);
+            break;
+        case RIG_MACRO_MODE:
+            retcode = tape_set_mode(my_rig, RIG_VFO_CURR, step.mode, RIG_PASSBAND_NOCHANGE);
+            if (retcode == RIG_OK) mode = step.mode;
+            break;
+        case RIG_MACRO_BW:
+            retcode = tape_set_mode(my_rig, RIG_VFO_CURR, mode, step.value);
+            break;
+        case RIG_MACRO_AGC:
+            retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_AGC, step.level);
+            break;
+        case RIG_MACRO_POWER:
+            retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_RFPOWER, step.level);
+            break;
+        case RIG_MACRO_ATT:
+            retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_ATT, step.level);
+            break;
+        case RIG_MACRO_PRE:
+            retcode = tape_set_level(my_rig, RIG_VFO_CURR, RIG_LEVEL_PREAMP, step.level);
+            break;
+        case RIG_MACRO_SPLIT:
+            retcode = tape_set_split_vfo(my_rig, rigGet.vfoMain, (split_t)step.value, step.value ? rigGet.vfoSub : rigGet.vfoMain);
+            break;
+        case RIG_MACRO_TXFREQ:
+            retcode = tape_set_split_freq(my_rig, RIG_VFO_CURR, step.freq);
+            break;
+        case RIG_MACRO_ANT:
+            retvalue.i = 0;
+            retcode = tape_set_ant(my_rig, RIG_VFO_CURR, step.value, retvalue);
+            break;
+        case RIG_MACRO_WAIT:
+        {
+            rigLocker.unlock(); //Release the rig so that the poll keeps running, PTT included
+            scheduleBusy.storeRelease(busy);
+
+            QElapsedTimer wait;
+            wait.start();
+            while (!scanAbort.loadAcquire() && !pttRequest.loadAcquire() && wait.elapsed() < step.value) QThread::msleep(qBound<qint64>(1, step.value - wait.elapsed(), 50));
+
+            busy = scheduleBusy.fetchAndStoreOrdered(1);
+            rigLocker.relock();
+            break;
+        }
+        }
+
+        results.append(retcode == RIG_OK ? "OK" : rigerror(retcode));
+    }
+
+    indexCmd = 0;   //Full poll, the new settings reach the GUI from the rig
+    rigLocker.unlock();
+    scheduleBusy.storeRelease(busy);
+
+    qInfo() << "Macro" << name << clock.elapsed() << "ms" << results;
+    emit macroDone(name, results);
+}
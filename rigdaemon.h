@@ -21,8 +21,18 @@
 #define RIGDAEMON_H
 
 #include <QObject>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
 #include <rig.h>
 
+#include "rigdata.h"
+#include "guidata.h"
+#include "survey.h"
+#include "rigstats.h"
+
 
 class RigDaemon : public QObject
 {
@@ -33,12 +43,61 @@ public:
     RIG *rigConnect(unsigned rigModel, QString rigPort, unsigned serialSpeed, unsigned serialDataBits, unsigned serialParity, unsigned serialStopBits, unsigned serialHandshake, int civAddr, bool autoPowerOn, int *retcode);
     RIG *rigConnect(unsigned rigModel, QString rigPort, bool autoPowerOn, int *retcode);
     void rigUpdate(RIG *my_rig, bool fullPoll);
+    void setState(rigSettings *get, rigSettings *set, rigCommand *cmd, rigCommand *cap, guiCommand *gcmd);   //Select the session state store
+    void scanRun(RIG *my_rig, scanConfig scan);  //Scan loop, runs on the worker thread until scanStop()
+    void scanStop();    //Thread safe
+    void requestPtt();  //PTT command queued, thread safe, ends a running scan, survey or macro
+    void surveyRun(RIG *my_rig, scanConfig scan, int interval, SurveyFile *survey);    //Survey loop, one row per sweep every interval (s)
+    void memoryRead(RIG *my_rig, QList<int> channels, QList<rigChannel> *result);  //Read memory channels, cancel with scanStop()
+    void memoryWrite(RIG *my_rig, QList<rigChannel> channels);  //Program memory channels, cancel with scanStop()
+    void macroRun(RIG *my_rig, QString name, QList<rigMacroStep> steps);   //Run a parsed macro as one batch
+    quint64 takeChanges();  //RIG_CHANGED_* mask since the last call, thread safe
+    void markAllChanged();  //Next takeChanges() returns everything, e.g. after connect or session switch
+
+    RigStats stats; //Link statistics of this session's rig
 
 public slots:
+    void scheduleStart(RIG *my_rig);    //Start the timed command scheduler, runs on the worker thread
+    void scheduleStop();
+    void scheduleAdd(QList<rigEvent> events);  //Queue timed commands
 
 signals:
     void resultReady();
+    void scanStatus(double freq, int strength, double rate, bool hold);    //Channels per second
+    void scanFinished();
+    void surveyRow(quint64 count, qint64 sweepTime);   //Row appended, sweep duration (ms)
+    void scheduleFired(QString tag, int type, double freq, int value, int strength, qint64 utc, double lateness, int retcode);  //Event done, lateness (ms) against the UTC deadline
+    void scheduleEmpty();   //No more queued events
+    void memoryProgress(int done, int total);
+    void memoryDone(int count, int retcode);   //Channels read or written, last hamlib retcode
+    void macroDone(QString name, QStringList results);  //One result per step
+
+private:
+    bool scanRead(RIG *my_rig, freq_t freq, int dwell, value_t *strength);
+    int scanDwellMin();
+    void publishChanges();
+    void scheduleArm();
+    void scheduleFire();
+
+    rigSettings *stateGet, *stateSet;   //Session state store, default the global rigGet/rigSet
+    rigCommand *stateCmd, *stateCap;
+    guiCommand *stateGuiCmd;
+    int indexCmd;   //Poll index
+    QAtomicInt scanAbort;
+    double linkSet, linkRead;   //set_freq and STRENGTH read round trip estimates (us)
+    QAtomicInt pttRequest;  //rigCmd.ptt as seen by the worker thread
+    rigSettings published = {}; //rigGet at the last publishChanges()
+    QAtomicInteger<quint64> changeMask = RIG_CHANGED_ALL;
 
+    //Timed command scheduler
+    QMutex rigMutex;    //Serializes the poll (GUI thread) and the scheduler (worker thread) on the rig
+    RIG *scheduleRig = nullptr;
+    QList<rigEvent> schedule;   //Sorted by deadline
+    QTimer *scheduleTimer = nullptr;
+    QElapsedTimer monoClock;    //Monotonic time base
+    qint64 deadlineMono;    //Deadline of the armed event on monoClock (ms)
+    double leadFreq;    //set_freq latency estimate (ms), frequency changes are sent this much in advance
+    QAtomicInt scheduleBusy;    //An event is imminent, the poll keeps off the rig
 };
 
 #endif // RIGDAEMON_H
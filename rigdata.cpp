@@ -24,3 +24,12 @@ rigSettings rigGet;
 rigSettings rigSet;
 rigCommand rigCmd;
 rigCommand rigCap;
+
+rigSession rigSess[RIG_SESSION_MAX];    //Parked rig sessions, the active one lives in the globals above
+int rigSessActive = 0;  //Active rig session index
+
+rigFollowConfig followConf;
+rotConnection rotCom;
+ampConnection ampCom;
+scanConfig scanConf;
+QList<rigMacro> macroConf;
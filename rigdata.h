@@ -20,11 +20,10 @@
 #ifndef RIGDATA_H
 #define RIGDATA_H
 
-#endif // RIGDATA_H
-
 #include <rig.h>    //Hamlib
 
 #include <QString>
+#include <QList>
 
 typedef struct {
     unsigned rigModel;  //Hamlib rig model
@@ -41,6 +40,9 @@ typedef struct {
     bool fullPoll;  //full polling flag
     bool autoConnect; //Auto-connect flag
     bool autoPowerOn;   //Auto Power ON flag
+    unsigned pollBudget;    //Poll interval while in background (ms)
+    QString profile;    //Profile name
+    bool standby;   //Open on startup and keep polling in background
 } rigConnection;
 
 typedef struct {
@@ -89,6 +91,36 @@ typedef struct {
     int voiceMem;   //Voice memory keyer
 } rigSettings;
 
+//rigSettings change mask, published by RigDaemon with each poll
+#define RIG_CHANGED_POWER (1ULL << 0)
+#define RIG_CHANGED_FREQ_MAIN (1ULL << 1)
+#define RIG_CHANGED_FREQ_SUB (1ULL << 2)
+#define RIG_CHANGED_VFO (1ULL << 3)     //vfoMain, vfoSub, vfoTx
+#define RIG_CHANGED_MODE (1ULL << 4)
+#define RIG_CHANGED_MODE_SUB (1ULL << 5)
+#define RIG_CHANGED_BW (1ULL << 6)      //bwidth, bwNarrow
+#define RIG_CHANGED_SPLIT (1ULL << 7)
+#define RIG_CHANGED_PTT (1ULL << 8)
+#define RIG_CHANGED_METER (1ULL << 9)   //sMeter, powerMeter, subMeter, hiSWR
+#define RIG_CHANGED_TUNER (1ULL << 10)
+#define RIG_CHANGED_AGC (1ULL << 11)
+#define RIG_CHANGED_ATT (1ULL << 12)
+#define RIG_CHANGED_PRE (1ULL << 13)
+#define RIG_CHANGED_RF_POWER (1ULL << 14)
+#define RIG_CHANGED_RF_GAIN (1ULL << 15)
+#define RIG_CHANGED_AF_GAIN (1ULL << 16)
+#define RIG_CHANGED_SQUELCH (1ULL << 17)
+#define RIG_CHANGED_MIC (1ULL << 18)    //micGain, micComp, micMon and levels
+#define RIG_CHANGED_NB (1ULL << 19)     //noiseBlanker, noiseBlanker2
+#define RIG_CHANGED_NR (1ULL << 20)     //noiseReduction and level
+#define RIG_CHANGED_NF (1ULL << 21)
+#define RIG_CHANGED_IF_SHIFT (1ULL << 22)
+#define RIG_CHANGED_CLAR (1ULL << 23)   //clar, rit, xit and offsets
+#define RIG_CHANGED_CW (1ULL << 24)     //bkin, apf, wpm
+#define RIG_CHANGED_RPT (1ULL << 25)    //rptShift, rptOffset
+#define RIG_CHANGED_TONE (1ULL << 26)   //toneType, tone
+#define RIG_CHANGED_ALL (~0ULL)
+
 typedef struct {
     int onoff;
     int freqMain, freqSub;
@@ -126,3 +158,100 @@ typedef struct {
     int micGain, micMonLevel, micCompLevel;
     int voiceSend;  //Voice send memory
 } rigCommand;
+
+
+#define RIG_SESSION_MAX 4   //Max number of rig sessions, one per connection profile
+
+typedef struct {
+    RIG *rig;   //Hamlib rig handle
+    rigConnection com;  //Connection config
+    rigSettings get, set;   //State store
+    rigCommand cmd, cap;    //Command flags and caps
+} rigSession;
+
+typedef struct {
+    unsigned rigModel;  //Follower Hamlib model (1 = Dummy, 2 = NET rigctl)
+    QString rigPort;    //Follower port or rigctld address
+    unsigned serialSpeed;
+    int offset;     //Frequency offset from the main rig (Hz)
+    bool followMode;    //Mirror the mode too
+} rigFollowConfig;
+
+typedef struct {
+    unsigned rotModel;  //Hamlib rotator model (1 = Dummy, 2 = NET rotctl)
+    QString rotPort;    //Rotator port or rotctld address
+    unsigned serialSpeed;
+    int pollFast;   //Poll interval while moving (ms)
+    int pollSlow;   //Poll interval while parked (ms)
+} rotConnection;
+
+typedef struct {
+    unsigned ampModel;  //Hamlib amplifier model (1 = Dummy, 2 = NET ampctl)
+    QString ampPort;    //Amplifier port or ampctld address
+    unsigned serialSpeed;
+    int pollFast;   //Poll interval while transmitting (ms)
+    int pollSlow;   //Poll interval while receiving (ms)
+} ampConnection;
+
+typedef struct {
+    freq_t start, stop, step;   //Frequency range (Hz)
+    QList<freq_t> list;    //Channel list, used instead of the range when not empty
+    int threshold;  //Squelch, STRENGTH level relative to S9 (dB)
+    int hang;   //Hang time after the signal drops (ms)
+    int dwell;  //Initial dwell between set_freq and STRENGTH read (ms)
+    int dwellMax;   //Adaptive dwell upper bound (ms)
+} scanConfig;
+
+#define RIG_EVENT_FREQ 1    //Set main VFO frequency, pre-staged by the measured latency
+#define RIG_EVENT_PTT 2     //Set PTT (value)
+#define RIG_EVENT_STRENGTH 3    //Read and report the S-meter
+
+typedef struct {
+    qint64 utc; //Deadline, UTC ms since epoch
+    int type;   //RIG_EVENT_*
+    freq_t freq;
+    int value;
+    QString tag;    //Reported with the result
+} rigEvent;
+
+typedef struct {
+    int num;    //Memory channel number
+    freq_t freq;    //0 = empty
+    rmode_t mode;
+    pbwidth_t width;
+    freq_t txFreq;
+    split_t split;
+    rptr_shift_t rptrShift;
+    shortfreq_t rptrOffs;
+    tone_t ctcss;   //CTCSS tone (0.1 Hz)
+    QString name;
+    int error;  //Hamlib return code of the read, RIG_OK if valid
+} rigChannel;
+
+#define RIG_MACRO_FREQ 1    //freq <Hz | MHz with decimal point>
+#define RIG_MACRO_MODE 2    //mode <hamlib mode | USB-D | LSB-D | FM-D>
+#define RIG_MACRO_BW 3      //bw <Hz | k suffix>
+#define RIG_MACRO_AGC 4     //agc <OFF | FAST | MEDIUM | SLOW | AUTO ...>
+#define RIG_MACRO_POWER 5   //power <%>
+#define RIG_MACRO_ATT 6     //att <dB>
+#define RIG_MACRO_PRE 7     //pre <dB>
+#define RIG_MACRO_SPLIT 8   //split <on | off>
+#define RIG_MACRO_TXFREQ 9  //txfreq <Hz | MHz>
+#define RIG_MACRO_ANT 10    //ant <ANT1 ...>
+#define RIG_MACRO_WAIT 11   //wait <ms>
+
+typedef struct {
+    int cmd;    //RIG_MACRO_*
+    freq_t freq;
+    rmode_t mode;
+    int value;
+    value_t level;
+} rigMacroStep;
+
+typedef struct {
+    QString name;
+    QString keys;   //Shortcut
+    QList<rigMacroStep> steps;  //Parsed script
+} rigMacro;
+
+#endif // RIGDATA_H
@@ -0,0 +1,156 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rigfollow.h"
+
+#include <QDebug>
+#include <QMutexLocker>
+
+
+RigFollow::RigFollow(QObject *parent) : QObject(parent)
+{
+    clock.start();
+}
+
+RigFollow::~RigFollow()
+{
+    close();
+}
+
+bool RigFollow::isOpen()
+{
+    return openFlag.loadAcquire();
+}
+
+//* Open the follower rig, runs on the follow thread
+void RigFollow::open(unsigned rigModel, QString rigPort, unsigned serialSpeed, int offset, bool followMode)
+{
+    close();
+
+    freqOffset = offset;
+    this->followMode = followMode;
+
+    follow_rig = rig_init(rigModel);
+    if (!follow_rig)    //Wrong Rig number
+    {
+        emit opened(-RIG_EINVAL);
+        return;
+    }
+
+    strncpy(follow_rig->state.rigport.pathname, rigPort.toLatin1(), HAMLIB_FILPATHLEN - 1);
+    if (serialSpeed) follow_rig->state.rigport.parm.serial.rate = serialSpeed;
+
+    int retcode = rig_open(follow_rig);
+    if (retcode != RIG_OK)
+    {
+        rig_cleanup(follow_rig);
+        follow_rig = nullptr;
+        emit opened(retcode);
+        return;
+    }
+
+    appliedFreq = 0;
+    appliedMode = RIG_MODE_NONE;
+    {
+        QMutexLocker locker(&mutex);    //Forget the target of the previous session, the next setTarget tunes the follower
+        targetFreq = 0;
+        targetMode = RIG_MODE_NONE;
+    }
+    openFlag.storeRelease(1);
+
+    qInfo() << "Follow rig open" << rigModel << rigPort;
+
+    emit opened(RIG_OK);
+}
+
+void RigFollow::close()
+{
+    openFlag.storeRelease(0);
+
+    if (follow_rig)
+    {
+        rig_close(follow_rig);
+        rig_cleanup(follow_rig);
+        follow_rig = nullptr;
+    }
+}
+
+//* Set the latest main VFO state, called from the GUI thread
+//* Rapid changes are coalesced: only one apply is queued at a time and it picks up the latest target
+void RigFollow::setTarget(freq_t freq, rmode_t mode)
+{
+    if (!isOpen()) return;
+
+    QMutexLocker locker(&mutex);
+
+    if (freq == targetFreq && mode == targetMode) return;
+
+    targetFreq = freq;
+    targetMode = mode;
+
+    if (!dirty)
+    {
+        dirty = true;
+        dirtyTime = clock.elapsed();
+        QMetaObject::invokeMethod(this, [this](){ apply(); }, Qt::QueuedConnection);
+    }
+}
+
+//* Apply the latest target to the follower rig, runs on the follow thread
+void RigFollow::apply()
+{
+    freq_t freq;
+    rmode_t mode;
+    qint64 changeTime;
+
+    {
+        QMutexLocker locker(&mutex);
+        freq = targetFreq;
+        mode = targetMode;
+        changeTime = dirtyTime;
+        dirty = false;
+    }
+
+    if (!follow_rig) return;
+
+    freq = freq + freqOffset;
+    bool failed = false;
+
+    if (freq != appliedFreq)
+    {
+        if (rig_set_freq(follow_rig, RIG_VFO_CURR, freq) == RIG_OK) appliedFreq = freq;
+        else failed = true;
+    }
+
+    if (followMode && mode != appliedMode && mode != RIG_MODE_NONE)
+    {
+        if (rig_set_mode(follow_rig, RIG_VFO_CURR, mode, RIG_PASSBAND_NOCHANGE) == RIG_OK) appliedMode = mode;
+        else failed = true;
+    }
+
+    if (failed) //Retry with the next setTarget, no lag for a failed apply
+    {
+        QMutexLocker locker(&mutex);
+        targetFreq = 0;
+        targetMode = RIG_MODE_NONE;
+        return;
+    }
+
+    emit lagUpdated(clock.elapsed() - changeTime);
+}
@@ -0,0 +1,69 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef RIGFOLLOW_H
+#define RIGFOLLOW_H
+
+#include <QObject>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <rig.h>
+
+
+class RigFollow : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RigFollow(QObject *parent = nullptr);
+    ~RigFollow();
+
+    void setTarget(freq_t freq, rmode_t mode);   //Thread safe, latest target wins
+    bool isOpen();
+
+public slots:
+    void open(unsigned rigModel, QString rigPort, unsigned serialSpeed, int offset, bool followMode);
+    void close();
+
+signals:
+    void opened(int retcode);
+    void lagUpdated(int lag);   //Tracking lag (ms)
+
+private:
+    void apply();
+
+    RIG *follow_rig = nullptr;
+    QAtomicInt openFlag;
+
+    QMutex mutex;   //Protects the target below
+    freq_t targetFreq = 0;
+    rmode_t targetMode = RIG_MODE_NONE;
+    bool dirty = false;     //Target changed and not yet applied
+    qint64 dirtyTime = 0;   //Time of the first not applied change
+
+    freq_t appliedFreq = 0;
+    rmode_t appliedMode = RIG_MODE_NONE;
+    int freqOffset = 0;
+    bool followMode = true;
+
+    QElapsedTimer clock;
+};
+
+#endif // RIGFOLLOW_H
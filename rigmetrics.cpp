@@ -0,0 +1,170 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rigmetrics.h"
+#include "rigstats.h"
+
+#include <QTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QDebug>
+
+
+RigMetrics::RigMetrics(QObject *parent)
+    : QObject{parent}
+{
+
+}
+
+void RigMetrics::start(int mode, QString fileName, int interval, int port)
+{
+    stop();
+
+    if (mode == METRICS_FILE)
+    {
+        metricsFileName = fileName;
+        fileTimer = new QTimer(this);
+        connect(fileTimer, &QTimer::timeout, this, &RigMetrics::writeFile);
+        fileTimer->start(qMax(1, interval) * 1000);
+        qInfo() << "Metrics textfile" << fileName << interval << "s";
+    }
+    else if (mode == METRICS_HTTP)
+    {
+        server = new QTcpServer(this);
+        connect(server, &QTcpServer::newConnection, this, &RigMetrics::on_newConnection);
+        if (server->listen(QHostAddress::LocalHost, port)) qInfo() << "Metrics endpoint http://localhost:" << port << "/metrics";
+        else qWarning() << "Metrics endpoint error" << server->errorString();
+    }
+}
+
+void RigMetrics::stop()
+{
+    if (fileTimer)
+    {
+        delete fileTimer;
+        fileTimer = nullptr;
+    }
+    if (server)
+    {
+        server->close();
+        delete server;
+        server = nullptr;
+    }
+}
+
+//* Rewritten atomically, the collector never reads a partial file
+void RigMetrics::writeFile()
+{
+    QSaveFile file(metricsFileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return;
+    file.write(serialize().toUtf8());
+    if (!file.commit()) qWarning() << "Metrics write error" << metricsFileName;
+}
+
+//* Serialised only on request, nothing is done while nobody scrapes
+void RigMetrics::on_newConnection()
+{
+    while (QTcpSocket *socket = server->nextPendingConnection())
+    {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, socket, [socket]()
+        {
+            if (!socket->canReadLine()) return;
+            QByteArray request = socket->readLine();
+
+            QByteArray body, status;
+            if (request.startsWith("GET /metrics ") || request.startsWith("GET / "))
+            {
+                status = "200 OK";
+                body = serialize().toUtf8();
+            }
+            else
+            {
+                status = "404 Not Found";
+                body = "Not found\n";
+            }
+
+            socket->write("HTTP/1.0 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " + QByteArray::number(body.size()) + "\r\nConnection: close\r\n\r\n");
+            socket->write(body);
+            socket->disconnectFromHost();
+        });
+    }
+}
+
+QString RigMetrics::serialize()
+{
+    QString text;
+    QTextStream out(&text);
+    const RigStats *stats = RigStats::active(); //Active session, counters restart on a session switch
+    if (!stats) return text;
+
+    auto header = [&out](const char *name, const char *type, const char *help)
+    {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+    };
+
+    auto summary = [&out](const QString &name, const QString &label, const StatsHistogram &hist)
+    {
+        QString sep = label.isEmpty() ? "" : ",";
+        out << name << "{" << label << sep << "quantile=\"0.5\"} " << hist.percentile(0.5) / 1e6 << "\n";
+        out << name << "{" << label << sep << "quantile=\"0.9\"} " << hist.percentile(0.9) / 1e6 << "\n";
+        out << name << "{" << label << sep << "quantile=\"0.99\"} " << hist.percentile(0.99) / 1e6 << "\n";
+        QString labels = label.isEmpty() ? "" : "{" + label + "}";
+        out << name << "_sum" << labels << " " << hist.sum() / 1e6 << "\n";
+        out << name << "_count" << labels << " " << hist.count() << "\n";
+    };
+
+    header("catradio_poll_seconds", "summary", "Poll cycle duration.");
+    summary("catradio_poll_seconds", "", stats->pollTime);
+
+    header("catradio_hamlib_call_seconds", "summary", "Hamlib call duration.");
+    for (int call = 1; call < TAPE_CALL_MAX; call++)
+        if (stats->callTime[call].count()) summary("catradio_hamlib_call_seconds", QString("call=\"%1\"").arg(tape_call_name(call)), stats->callTime[call]);
+
+    header("catradio_hamlib_errors_total", "counter", "Hamlib calls returning an error.");
+    for (int call = 1; call < TAPE_CALL_MAX; call++)
+        if (stats->callTime[call].count()) out << "catradio_hamlib_errors_total{call=\"" << tape_call_name(call) << "\"} " << stats->errors[call].loadRelaxed() << "\n";
+
+    header("catradio_hamlib_timeouts_total", "counter", "Hamlib calls timed out.");
+    for (int call = 1; call < TAPE_CALL_MAX; call++)
+        if (stats->callTime[call].count()) out << "catradio_hamlib_timeouts_total{call=\"" << tape_call_name(call) << "\"} " << stats->timeouts[call].loadRelaxed() << "\n";
+
+    header("catradio_connects_total", "counter", "Rig connection attempts.");
+    out << "catradio_connects_total " << stats->callTime[TAPE_CALL_OPEN].count() << "\n";
+
+    header("catradio_commands_total", "counter", "Commands sent to the rig.");
+    out << "catradio_commands_total " << stats->commands.loadRelaxed() << "\n";
+
+    header("catradio_queue_depth", "gauge", "Pending commands at the last poll.");
+    out << "catradio_queue_depth " << stats->queueDepth.loadRelaxed() << "\n";
+
+    header("catradio_link_busy_seconds_total", "counter", "Time spent inside Hamlib calls.");
+    out << "catradio_link_busy_seconds_total " << stats->busy.loadRelaxed() / 1e6 << "\n";
+
+    header("catradio_ptt_seconds_total", "counter", "Time in transmission.");
+    out << "catradio_ptt_seconds_total " << stats->pttTime.loadRelaxed() / 1e6 << "\n";
+
+    header("catradio_swr_max", "gauge", "Highest SWR read in transmission.");
+    out << "catradio_swr_max " << stats->swrMax.loadRelaxed() / 1000.0 << "\n";
+
+    out.flush();
+    return text;
+}
@@ -0,0 +1,58 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef RIGMETRICS_H
+#define RIGMETRICS_H
+
+#include <QObject>
+#include <QString>
+
+class QTimer;
+class QTcpServer;
+
+#define METRICS_OFF 0
+#define METRICS_FILE 1  //node_exporter textfile collector
+#define METRICS_HTTP 2  //localhost endpoint, GET /metrics
+
+
+//* Prometheus text format export of the link statistics, lives in its own thread
+class RigMetrics : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RigMetrics(QObject *parent = nullptr);
+
+    static QString serialize();
+
+public slots:
+    void start(int mode, QString fileName, int interval, int port);
+    void stop();
+
+private slots:
+    void writeFile();
+    void on_newConnection();
+
+private:
+    QTimer *fileTimer = nullptr;
+    QTcpServer *server = nullptr;
+    QString metricsFileName;
+};
+
+#endif // RIGMETRICS_H
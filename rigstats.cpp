@@ -0,0 +1,181 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rigstats.h"
+
+#include <QtAlgorithms>
+#include <QDebug>
+
+#include <cstring>
+
+static QAtomicPointer<RigStats> statsTable[STATS_RIGS];
+static QAtomicPointer<RigStats> statsActive;
+
+
+//***** StatsHistogram *****
+
+int StatsHistogram::bucketIndex(qint64 us)
+{
+    if (us < STATS_LINEAR) return us < 0 ? 0 : int(us);
+
+    int exponent = 63 - qCountLeadingZeroBits(quint64(us));   //us >= 2^exponent, exponent >= 4
+    int sub = int(us >> (exponent - 3)) & (STATS_SUB - 1);
+    int index = STATS_LINEAR + (exponent - 4) * STATS_SUB + sub;
+    return qMin(index, STATS_BUCKETS - 1);
+}
+
+qint64 StatsHistogram::bucketValue(int index)
+{
+    if (index < STATS_LINEAR) return index;
+
+    int exponent = (index - STATS_LINEAR) / STATS_SUB + 4;
+    int sub = (index - STATS_LINEAR) % STATS_SUB;
+    return (qint64(STATS_SUB + sub + 1) << (exponent - 3)) - 1;
+}
+
+void StatsHistogram::add(qint64 us)
+{
+    buckets[bucketIndex(us)].fetchAndAddRelaxed(1);
+    total.fetchAndAddRelaxed(1);
+    totalValue.fetchAndAddRelaxed(us < 0 ? 0 : us);
+
+    qint64 current = maxValue.loadRelaxed();
+    while (us > current && !maxValue.testAndSetRelaxed(current, us)) current = maxValue.loadRelaxed();
+}
+
+void StatsHistogram::reset()
+{
+    for (int i = 0; i < STATS_BUCKETS; i++) buckets[i].storeRelaxed(0);
+    total.storeRelaxed(0);
+    totalValue.storeRelaxed(0);
+    maxValue.storeRelaxed(0);
+}
+
+qint64 StatsHistogram::percentile(double p) const
+{
+    quint64 n = count();
+    if (!n) return 0;
+
+    quint64 rank = quint64(p * n);
+    quint64 sum = 0;
+    for (int i = 0; i < STATS_BUCKETS; i++)
+    {
+        sum += buckets[i].loadRelaxed();
+        if (sum > rank) return qMin(bucketValue(i), max());
+    }
+    return max();
+}
+
+
+//***** RigStats *****
+
+RigStats::RigStats()
+{
+    clock.start();
+
+    for (int i = 0; i < STATS_RIGS; i++) if (statsTable[i].testAndSetOrdered(nullptr, this)) return;
+    qWarning() << "Link statistics table full";
+}
+
+RigStats::~RigStats()
+{
+    statsActive.testAndSetOrdered(this, nullptr);
+    for (int i = 0; i < STATS_RIGS; i++) statsTable[i].testAndSetOrdered(this, nullptr);
+}
+
+void RigStats::attach(RIG *rig)
+{
+    for (int i = 0; i < STATS_RIGS; i++)    //A freed handle can come back from rig_init in another session
+    {
+        RigStats *stats = statsTable[i].loadAcquire();
+        if (stats && stats != this) stats->rigHandle.testAndSetOrdered(rig, nullptr);
+    }
+    rigHandle.storeRelease(rig);
+}
+
+RigStats *RigStats::find(RIG *rig)
+{
+    if (!rig) return nullptr;
+
+    for (int i = 0; i < STATS_RIGS; i++)
+    {
+        RigStats *stats = statsTable[i].loadAcquire();
+        if (stats && stats->rigHandle.loadAcquire() == rig) return stats;
+    }
+    return nullptr;
+}
+
+void RigStats::setActive(RigStats *stats)
+{
+    statsActive.storeRelease(stats);
+}
+
+RigStats *RigStats::active()
+{
+    return statsActive.loadAcquire();
+}
+
+void RigStats::call(int call, qint64 us, int retcode)
+{
+    if (call <= 0 || call >= TAPE_CALL_MAX) return;
+
+    callTime[call].add(us);
+    busy.fetchAndAddRelaxed(us);
+
+    if (retcode != RIG_OK)
+    {
+        errors[call].fetchAndAddRelaxed(1);
+        if (retcode == -RIG_ETIMEOUT) timeouts[call].fetchAndAddRelaxed(1);
+    }
+
+    if (!strncmp(tape_call_name(call), "set", 3) || call == TAPE_CALL_VFO_OP) commands.fetchAndAddRelaxed(1);
+}
+
+void RigStats::poll(qint64 us, int queue)
+{
+    pollTime.add(us);
+    queueDepth.storeRelaxed(queue);
+}
+
+//* PTT time and SWR peak, sampled at every poll
+void RigStats::tx(bool ptt, float swr)
+{
+    qint64 time = now();
+    qint64 last = lastTx.fetchAndStoreRelaxed(time);
+    if (ptt && lastPtt.loadRelaxed() && last) pttTime.fetchAndAddRelaxed(time - last);
+    lastPtt.storeRelaxed(ptt);
+
+    int swrValue = qRound(swr * 1000);
+    if (ptt && swrValue > swrMax.loadRelaxed()) swrMax.storeRelaxed(swrValue);
+}
+
+void RigStats::reset()
+{
+    pollTime.reset();
+    for (int i = 0; i < TAPE_CALL_MAX; i++)
+    {
+        callTime[i].reset();
+        errors[i].storeRelaxed(0);
+        timeouts[i].storeRelaxed(0);
+    }
+    commands.storeRelaxed(0);
+    busy.storeRelaxed(0);
+    pttTime.storeRelaxed(0);
+    swrMax.storeRelaxed(0);
+}
@@ -0,0 +1,93 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef RIGSTATS_H
+#define RIGSTATS_H
+
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+
+#include "rigtape.h"
+
+#define STATS_LINEAR 16 //Exact buckets below 16 us
+#define STATS_SUB 8     //Buckets per octave above, 12.5% resolution
+#define STATS_BUCKETS (STATS_LINEAR + STATS_SUB * 24)   //Up to about 4 min
+#define STATS_RIGS 8    //Max RigStats instances, one per rig session
+
+
+//* Log-linear latency histogram (us), fixed memory, lock free
+class StatsHistogram
+{
+public:
+    void add(qint64 us);
+    void reset();
+    quint64 count() const { return total.loadRelaxed(); }
+    quint64 sum() const { return totalValue.loadRelaxed(); }
+    qint64 percentile(double p) const;  //Upper bound of the bucket
+    qint64 max() const { return maxValue.loadRelaxed(); }
+    quint32 bucket(int index) const { return buckets[index].loadRelaxed(); }
+
+    static int bucketIndex(qint64 us);
+    static qint64 bucketValue(int index);
+
+private:
+    QAtomicInteger<quint32> buckets[STATS_BUCKETS] = {};
+    QAtomicInteger<quint64> total = 0;
+    QAtomicInteger<quint64> totalValue = 0;
+    QAtomicInteger<qint64> maxValue = 0;
+};
+
+
+//* Rig link counters of one rig handle, updated by every Hamlib call on it and every poll cycle
+class RigStats
+{
+public:
+    RigStats();
+    ~RigStats();
+
+    void attach(RIG *rig);  //Count the Hamlib calls made on rig, a new handle from rig_init
+    static RigStats *find(RIG *rig);    //Stats attached to rig, nullptr if none, lock free
+    static void setActive(RigStats *stats); //Stats of the active session, shown and exported
+    static RigStats *active();
+
+    qint64 now() const { return clock.nsecsElapsed() / 1000; }  //us
+    void call(int call, qint64 us, int retcode);
+    void poll(qint64 us, int queue);
+    void tx(bool ptt, float swr);
+    void reset();
+
+    StatsHistogram pollTime;
+    StatsHistogram callTime[TAPE_CALL_MAX];
+    QAtomicInteger<quint32> errors[TAPE_CALL_MAX] = {};
+    QAtomicInteger<quint32> timeouts[TAPE_CALL_MAX] = {};
+    QAtomicInteger<quint64> commands = 0;   //Set calls
+    QAtomicInteger<quint64> busy = 0;   //Time spent in Hamlib calls (us)
+    QAtomicInteger<int> queueDepth = 0; //Pending commands at the last poll
+    QAtomicInteger<quint64> pttTime = 0;    //Time in transmission (us)
+    QAtomicInteger<int> swrMax = 0; //Highest SWR in transmission x1000
+
+private:
+    QElapsedTimer clock;
+    QAtomicInteger<qint64> lastTx = 0;
+    QAtomicInteger<int> lastPtt = 0;
+    QAtomicPointer<RIG> rigHandle = nullptr;
+};
+
+#endif // RIGSTATS_H
@@ -0,0 +1,532 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rigtape.h"
+#include "rigstats.h"
+#include "rigtrace.h"
+#include "debuglogger.h"
+#include "flightrecorder.h"
+
+#include <QDateTime>
+#include <QThread>
+#include <QRandomGenerator>
+#include <QDebug>
+
+#include <cstring>
+
+
+static_assert(sizeof(tapeRecord) == 56, "tapeRecord must be packed");
+
+RigTape rigTape;
+
+
+RigTape::RigTape()
+{
+    tapeMode = TAPE_OFF;
+    tapeModel = 0;
+    replaySpeed = 1;
+    injectLatency = 0;
+    injectJitter = 0;
+}
+
+RigTape::~RigTape()
+{
+    close();
+}
+
+bool RigTape::record(QString fileName, rig_model_t model)
+{
+    close();
+
+    QMutexLocker locker(&mutex);
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Tape" << fileName << file.errorString();
+        return false;
+    }
+
+    tapeHeader header = {};
+    strncpy(header.magic, "CRTAPE1", sizeof(header.magic));
+    header.rigModel = model;
+    header.recordSize = sizeof(tapeRecord);
+    header.utc = QDateTime::currentMSecsSinceEpoch();
+    file.write((const char *)&header, sizeof(header));
+
+    tapeModel = model;
+    tapeMode = TAPE_RECORD;
+    clock.start();
+
+    qInfo() << "Tape record" << fileName;
+    return true;
+}
+
+bool RigTape::replay(QString fileName, double speed)
+{
+    close();
+
+    QMutexLocker locker(&mutex);
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Tape" << fileName << file.errorString();
+        return false;
+    }
+
+    tapeHeader header;
+    if (file.read((char *)&header, sizeof(header)) != sizeof(header) || strncmp(header.magic, "CRTAPE1", 8) || header.recordSize != sizeof(tapeRecord))
+    {
+        qWarning() << "Tape" << fileName << "invalid format";
+        file.close();
+        return false;
+    }
+
+    //* Load the responses, queued by call, VFO and argument
+    tapeRecord rec;
+    int count = 0;
+    while (file.read((char *)&rec, sizeof(rec)) == sizeof(rec))
+    {
+        replayQueue[qMakePair(qMakePair(int(rec.call), rec.vfo), rec.arg)].enqueue(rec);
+        count++;
+    }
+    file.close();
+
+    tapeModel = header.rigModel;
+    replaySpeed = speed;
+    tapeMode = TAPE_REPLAY;
+
+    qInfo() << "Tape replay" << fileName << count << "calls, model" << tapeModel << "speed" << speed;
+    return true;
+}
+
+void RigTape::close()
+{
+    QMutexLocker locker(&mutex);
+
+    if (file.isOpen()) file.close();
+    replayQueue.clear();
+    tapeMode = TAPE_OFF;
+    tapeRig.storeRelease(nullptr);
+}
+
+void RigTape::bind(RIG *rig)
+{
+    QMutexLocker locker(&mutex);
+    if (tapeMode != TAPE_OFF && !tapeRig.loadRelaxed()) tapeRig.storeRelease(rig);  //Published after the tape mode
+}
+
+void RigTape::setLatency(int latency, int jitter)
+{
+    injectLatency = qMax(0, latency);
+    injectJitter = qMax(0, jitter);
+}
+
+void RigTape::delay()
+{
+    if (!injectLatency && !injectJitter) return;
+    QThread::usleep(injectLatency + (injectJitter ? QRandomGenerator::global()->bounded(injectJitter + 1) : 0));
+}
+
+qint64 RigTape::begin()
+{
+    return clock.nsecsElapsed() / 1000;
+}
+
+void RigTape::store(tapeRecord &rec, qint64 start)
+{
+    rec.time = start;
+    rec.duration = begin() - start;
+
+    QMutexLocker locker(&mutex);
+    if (tapeMode == TAPE_RECORD) file.write((const char *)&rec, sizeof(rec));
+}
+
+//* The last response of each call is kept, the rig holds its final state
+bool RigTape::fetch(tapeRecord &rec)
+{
+    tapeRecord found;
+    {
+        QMutexLocker locker(&mutex);
+
+        auto it = replayQueue.find(qMakePair(qMakePair(int(rec.call), rec.vfo), rec.arg));
+        if (it == replayQueue.end() || it->isEmpty()) return false;
+        found = (it->size() > 1) ? it->dequeue() : it->head();
+    }
+
+    if (replaySpeed > 0) QThread::usleep(found.duration / replaySpeed);  //Original or accelerated rig latency
+
+    rec.retcode = found.retcode;
+    rec.out[0] = found.out[0];
+    rec.out[1] = found.out[1];
+    return true;
+}
+
+
+//***** Hamlib wrappers *****
+
+const char *tape_call_name(int call)
+{
+    static const char *name[TAPE_CALL_MAX] = {"", "open", "get_freq", "set_freq", "get_mode", "set_mode", "get_vfo",
+        "get_split_vfo", "set_split_vfo", "set_split_freq", "get_ptt", "set_ptt", "get_powerstat", "set_powerstat",
+        "get_level", "set_level", "get_func", "set_func", "get_ant", "set_ant", "get_rit", "set_rit", "get_xit", "set_xit",
+        "get_rptr_shift", "set_rptr_shift", "get_rptr_offs", "set_rptr_offs", "get_ctcss", "set_ctcss", "get_dcs", "set_dcs",
+        "vfo_op", "send_morse", "send_voice", "get_channel", "set_channel"};
+
+    if (call <= 0 || call >= TAPE_CALL_MAX) return "";
+    return name[call];
+}
+
+static quint64 packFreq(double value)
+{
+    quint64 raw;
+    memcpy(&raw, &value, sizeof(raw));
+    return raw;
+}
+
+static double unpackFreq(quint64 raw)
+{
+    double value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+static quint64 packValue(value_t value)
+{
+    quint64 raw = 0;
+    memcpy(&raw, &value, qMin(sizeof(value), sizeof(raw)));    //i, u and f
+    return raw;
+}
+
+static value_t unpackValue(quint64 raw)
+{
+    value_t value;
+    memset(&value, 0, sizeof(value));
+    memcpy(&value, &raw, qMin(sizeof(value), sizeof(raw)));
+    return value;
+}
+
+//* Run the live call and record it, or return the recorded response
+//* The live call is a template parameter, inlined without a heap allocated std::function
+template <typename Live>
+static int tapeCall(RIG *rig, quint8 call, vfo_t vfo, quint64 arg, quint64 in, quint64 out[2], const Live &live)
+{
+    TraceScope trace("hamlib", tape_call_name(call));
+    RigStats *stats = RigStats::find(rig);
+    qint64 callStart = stats ? stats->now() : 0;
+    int retcode;
+
+    rigTape.delay();
+
+    if (!rigTape.covers(rig)) retcode = live();
+    else
+    {
+        tapeRecord rec = {};
+        rec.call = call;
+        rec.vfo = vfo;
+        rec.arg = arg;
+        rec.in = in;
+
+        if (rigTape.mode() == TAPE_REPLAY)
+        {
+            if (rigTape.fetch(rec))
+            {
+                out[0] = rec.out[0];
+                out[1] = rec.out[1];
+                retcode = rec.retcode;
+            }
+            else retcode = -RIG_ENAVAIL;    //Not on tape
+        }
+        else
+        {
+            qint64 start = rigTape.begin();
+            rec.retcode = live();
+            rec.out[0] = out[0];
+            rec.out[1] = out[1];
+            rigTape.store(rec, start);
+            retcode = rec.retcode;
+        }
+    }
+
+    if (stats) stats->call(call, stats->now() - callStart, retcode);
+    flightRecorder.result(call, retcode);
+    if (retcode != RIG_OK) debugLogger::log(QtInfoMsg, "hamlib", "%s vfo %x error %d", tape_call_name(call), vfo, retcode);
+    return retcode;
+}
+
+int tape_open(RIG *rig)
+{
+    quint64 out[2] = {0, 0};
+    rigTape.bind(rig);
+    return tapeCall(rig, TAPE_CALL_OPEN, 0, 0, 0, out, [&](){ return rig_open(rig); });   //The port is not opened on replay
+}
+
+int tape_get_freq(RIG *rig, vfo_t vfo, freq_t *freq)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_FREQ, vfo, 0, 0, out, [&](){ int r = rig_get_freq(rig, vfo, freq); out[0] = packFreq(*freq); return r; });
+    *freq = unpackFreq(out[0]);
+    return retcode;
+}
+
+int tape_set_freq(RIG *rig, vfo_t vfo, freq_t freq)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_FREQ, vfo, 0, packFreq(freq), out, [&](){ return rig_set_freq(rig, vfo, freq); });
+}
+
+int tape_get_mode(RIG *rig, vfo_t vfo, rmode_t *mode, pbwidth_t *width)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_MODE, vfo, 0, 0, out, [&](){ int r = rig_get_mode(rig, vfo, mode, width); out[0] = *mode; out[1] = *width; return r; });
+    *mode = out[0];
+    *width = out[1];
+    return retcode;
+}
+
+int tape_set_mode(RIG *rig, vfo_t vfo, rmode_t mode, pbwidth_t width)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_MODE, vfo, 0, mode, out, [&](){ return rig_set_mode(rig, vfo, mode, width); });
+}
+
+int tape_get_vfo(RIG *rig, vfo_t *vfo)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_VFO, 0, 0, 0, out, [&](){ int r = rig_get_vfo(rig, vfo); out[0] = *vfo; return r; });
+    *vfo = out[0];
+    return retcode;
+}
+
+int tape_get_split_vfo(RIG *rig, vfo_t vfo, split_t *split, vfo_t *txVfo)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_SPLIT_VFO, vfo, 0, 0, out, [&](){ int r = rig_get_split_vfo(rig, vfo, split, txVfo); out[0] = *split; out[1] = *txVfo; return r; });
+    *split = (split_t)out[0];
+    *txVfo = out[1];
+    return retcode;
+}
+
+int tape_set_split_vfo(RIG *rig, vfo_t vfo, split_t split, vfo_t txVfo)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_SPLIT_VFO, vfo, txVfo, split, out, [&](){ return rig_set_split_vfo(rig, vfo, split, txVfo); });
+}
+
+int tape_set_split_freq(RIG *rig, vfo_t vfo, freq_t txFreq)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_SPLIT_FREQ, vfo, 0, packFreq(txFreq), out, [&](){ return rig_set_split_freq(rig, vfo, txFreq); });
+}
+
+int tape_get_ptt(RIG *rig, vfo_t vfo, ptt_t *ptt)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_PTT, vfo, 0, 0, out, [&](){ int r = rig_get_ptt(rig, vfo, ptt); out[0] = *ptt; return r; });
+    *ptt = (ptt_t)out[0];
+    return retcode;
+}
+
+int tape_set_ptt(RIG *rig, vfo_t vfo, ptt_t ptt)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_PTT, vfo, 0, ptt, out, [&](){ return rig_set_ptt(rig, vfo, ptt); });
+}
+
+int tape_get_powerstat(RIG *rig, powerstat_t *status)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_POWERSTAT, 0, 0, 0, out, [&](){ int r = rig_get_powerstat(rig, status); out[0] = *status; return r; });
+    *status = (powerstat_t)out[0];
+    return retcode;
+}
+
+int tape_set_powerstat(RIG *rig, powerstat_t status)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_POWERSTAT, 0, 0, status, out, [&](){ return rig_set_powerstat(rig, status); });
+}
+
+int tape_get_level(RIG *rig, vfo_t vfo, setting_t level, value_t *val)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_LEVEL, vfo, level, 0, out, [&](){ int r = rig_get_level(rig, vfo, level, val); out[0] = packValue(*val); return r; });
+    *val = unpackValue(out[0]);
+    return retcode;
+}
+
+int tape_set_level(RIG *rig, vfo_t vfo, setting_t level, value_t val)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_LEVEL, vfo, level, packValue(val), out, [&](){ return rig_set_level(rig, vfo, level, val); });
+}
+
+int tape_get_func(RIG *rig, vfo_t vfo, setting_t func, int *status)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_FUNC, vfo, func, 0, out, [&](){ int r = rig_get_func(rig, vfo, func, status); out[0] = *status; return r; });
+    *status = out[0];
+    return retcode;
+}
+
+int tape_set_func(RIG *rig, vfo_t vfo, setting_t func, int status)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_FUNC, vfo, func, status, out, [&](){ return rig_set_func(rig, vfo, func, status); });
+}
+
+int tape_get_ant(RIG *rig, vfo_t vfo, ant_t ant, value_t *option, ant_t *antCurr, ant_t *antTx, ant_t *antRx)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_ANT, vfo, ant, 0, out, [&](){
+        int r = rig_get_ant(rig, vfo, ant, option, antCurr, antTx, antRx);
+        out[0] = (quint64(option->i) << 32) | *antCurr;
+        out[1] = (quint64(*antRx) << 32) | *antTx;
+        return r; });
+    option->i = qint32(out[0] >> 32);
+    *antCurr = out[0] & 0xffffffff;
+    *antTx = out[1] & 0xffffffff;
+    *antRx = out[1] >> 32;
+    return retcode;
+}
+
+int tape_set_ant(RIG *rig, vfo_t vfo, ant_t ant, value_t option)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_ANT, vfo, ant, packValue(option), out, [&](){ return rig_set_ant(rig, vfo, ant, option); });
+}
+
+int tape_get_rit(RIG *rig, vfo_t vfo, shortfreq_t *rit)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_RIT, vfo, 0, 0, out, [&](){ int r = rig_get_rit(rig, vfo, rit); out[0] = *rit; return r; });
+    *rit = out[0];
+    return retcode;
+}
+
+int tape_set_rit(RIG *rig, vfo_t vfo, shortfreq_t rit)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_RIT, vfo, 0, rit, out, [&](){ return rig_set_rit(rig, vfo, rit); });
+}
+
+int tape_get_xit(RIG *rig, vfo_t vfo, shortfreq_t *xit)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_XIT, vfo, 0, 0, out, [&](){ int r = rig_get_xit(rig, vfo, xit); out[0] = *xit; return r; });
+    *xit = out[0];
+    return retcode;
+}
+
+int tape_set_xit(RIG *rig, vfo_t vfo, shortfreq_t xit)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_XIT, vfo, 0, xit, out, [&](){ return rig_set_xit(rig, vfo, xit); });
+}
+
+int tape_get_rptr_shift(RIG *rig, vfo_t vfo, rptr_shift_t *shift)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_RPTR_SHIFT, vfo, 0, 0, out, [&](){ int r = rig_get_rptr_shift(rig, vfo, shift); out[0] = *shift; return r; });
+    *shift = (rptr_shift_t)out[0];
+    return retcode;
+}
+
+int tape_set_rptr_shift(RIG *rig, vfo_t vfo, rptr_shift_t shift)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_RPTR_SHIFT, vfo, 0, shift, out, [&](){ return rig_set_rptr_shift(rig, vfo, shift); });
+}
+
+int tape_get_rptr_offs(RIG *rig, vfo_t vfo, shortfreq_t *offs)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_RPTR_OFFS, vfo, 0, 0, out, [&](){ int r = rig_get_rptr_offs(rig, vfo, offs); out[0] = *offs; return r; });
+    *offs = out[0];
+    return retcode;
+}
+
+int tape_set_rptr_offs(RIG *rig, vfo_t vfo, shortfreq_t offs)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_RPTR_OFFS, vfo, 0, offs, out, [&](){ return rig_set_rptr_offs(rig, vfo, offs); });
+}
+
+int tape_get_ctcss_tone(RIG *rig, vfo_t vfo, tone_t *tone)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_CTCSS, vfo, 0, 0, out, [&](){ int r = rig_get_ctcss_tone(rig, vfo, tone); out[0] = *tone; return r; });
+    *tone = out[0];
+    return retcode;
+}
+
+int tape_set_ctcss_tone(RIG *rig, vfo_t vfo, tone_t tone)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_CTCSS, vfo, 0, tone, out, [&](){ return rig_set_ctcss_tone(rig, vfo, tone); });
+}
+
+int tape_get_dcs_code(RIG *rig, vfo_t vfo, tone_t *code)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_DCS, vfo, 0, 0, out, [&](){ int r = rig_get_dcs_code(rig, vfo, code); out[0] = *code; return r; });
+    *code = out[0];
+    return retcode;
+}
+
+int tape_set_dcs_code(RIG *rig, vfo_t vfo, tone_t code)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_DCS, vfo, 0, code, out, [&](){ return rig_set_dcs_code(rig, vfo, code); });
+}
+
+int tape_vfo_op(RIG *rig, vfo_t vfo, vfo_op_t op)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_VFO_OP, vfo, op, 0, out, [&](){ return rig_vfo_op(rig, vfo, op); });
+}
+
+int tape_send_morse(RIG *rig, vfo_t vfo, const char *msg)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SEND_MORSE, vfo, 0, strlen(msg), out, [&](){ return rig_send_morse(rig, vfo, msg); });
+}
+
+int tape_send_voice_mem(RIG *rig, vfo_t vfo, int ch)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SEND_VOICE, vfo, ch, 0, out, [&](){ return rig_send_voice_mem(rig, vfo, ch); });
+}
+
+//* Only frequency and mode of the memory channels are kept on tape
+int tape_get_channel(RIG *rig, vfo_t vfo, channel_t *chan, int readOnly)
+{
+    quint64 out[2] = {0, 0};
+    int retcode = tapeCall(rig, TAPE_CALL_GET_CHANNEL, vfo, chan->channel_num, 0, out, [&](){ int r = rig_get_channel(rig, vfo, chan, readOnly); out[0] = packFreq(chan->freq); out[1] = chan->mode; return r; });
+    chan->freq = unpackFreq(out[0]);
+    chan->mode = out[1];
+    return retcode;
+}
+
+int tape_set_channel(RIG *rig, vfo_t vfo, const channel_t *chan)
+{
+    quint64 out[2] = {0, 0};
+    return tapeCall(rig, TAPE_CALL_SET_CHANNEL, vfo, chan->channel_num, packFreq(chan->freq), out, [&](){ return rig_set_channel(rig, vfo, chan); });
+}
@@ -0,0 +1,173 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef RIGTAPE_H
+#define RIGTAPE_H
+
+#include <QFile>
+#include <QMutex>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QQueue>
+#include <QPair>
+
+#include <rig.h>
+
+#define TAPE_OFF 0
+#define TAPE_RECORD 1
+#define TAPE_REPLAY 2
+
+#define TAPE_CALL_OPEN 1
+#define TAPE_CALL_GET_FREQ 2
+#define TAPE_CALL_SET_FREQ 3
+#define TAPE_CALL_GET_MODE 4
+#define TAPE_CALL_SET_MODE 5
+#define TAPE_CALL_GET_VFO 6
+#define TAPE_CALL_GET_SPLIT_VFO 7
+#define TAPE_CALL_SET_SPLIT_VFO 8
+#define TAPE_CALL_SET_SPLIT_FREQ 9
+#define TAPE_CALL_GET_PTT 10
+#define TAPE_CALL_SET_PTT 11
+#define TAPE_CALL_GET_POWERSTAT 12
+#define TAPE_CALL_SET_POWERSTAT 13
+#define TAPE_CALL_GET_LEVEL 14
+#define TAPE_CALL_SET_LEVEL 15
+#define TAPE_CALL_GET_FUNC 16
+#define TAPE_CALL_SET_FUNC 17
+#define TAPE_CALL_GET_ANT 18
+#define TAPE_CALL_SET_ANT 19
+#define TAPE_CALL_GET_RIT 20
+#define TAPE_CALL_SET_RIT 21
+#define TAPE_CALL_GET_XIT 22
+#define TAPE_CALL_SET_XIT 23
+#define TAPE_CALL_GET_RPTR_SHIFT 24
+#define TAPE_CALL_SET_RPTR_SHIFT 25
+#define TAPE_CALL_GET_RPTR_OFFS 26
+#define TAPE_CALL_SET_RPTR_OFFS 27
+#define TAPE_CALL_GET_CTCSS 28
+#define TAPE_CALL_SET_CTCSS 29
+#define TAPE_CALL_GET_DCS 30
+#define TAPE_CALL_SET_DCS 31
+#define TAPE_CALL_VFO_OP 32
+#define TAPE_CALL_SEND_MORSE 33
+#define TAPE_CALL_SEND_VOICE 34
+#define TAPE_CALL_GET_CHANNEL 35
+#define TAPE_CALL_SET_CHANNEL 36
+#define TAPE_CALL_MAX 37
+
+//* One Hamlib call, fixed size little-endian record
+typedef struct {
+    quint8 call;    //TAPE_CALL_*
+    quint8 reserved[3];
+    qint32 retcode;
+    qint32 vfo;
+    quint32 duration;   //Call duration (us)
+    quint64 arg;    //Level, func, op or antenna
+    quint64 in;     //Input value
+    quint64 out[2]; //Output values
+    qint64 time;    //Call start since the tape start (us)
+} tapeRecord;
+
+typedef struct {
+    char magic[8];  //"CRTAPE1"
+    quint32 rigModel;
+    quint32 recordSize;
+    qint64 utc; //Tape start, ms since epoch
+} tapeHeader;
+
+
+class RigTape
+{
+public:
+    RigTape();
+    ~RigTape();
+
+    bool record(QString fileName, rig_model_t model);
+    bool replay(QString fileName, double speed);    //speed 1 = original timing, 0 = no delay
+    void close();
+    void setLatency(int latency, int jitter);  //Injected per-call delay (us), added to live and replayed calls
+    void delay();
+
+    int mode() const { return tapeMode; }
+    rig_model_t model() const { return tapeModel; }
+    RIG *rig() const { return tapeRig.loadAcquire(); }
+    void bind(RIG *rig);    //The first rig opened after record() or replay() owns the tape
+    bool covers(RIG *rig) const { return rig && tapeRig.loadAcquire() == rig; }  //Lock free, calls of the other rig sessions are live and not recorded
+
+    qint64 begin(); //Start of a recorded call (us)
+    void store(tapeRecord &rec, qint64 start);
+    bool fetch(tapeRecord &rec);    //Next recorded response for the same call and argument
+
+private:
+    QFile file;
+    QMutex mutex;
+    QElapsedTimer clock;
+    int tapeMode;
+    rig_model_t tapeModel;
+    QAtomicPointer<RIG> tapeRig;    //Rig handle the tape belongs to, nullptr while off or until opened
+    double replaySpeed;
+    int injectLatency, injectJitter;
+    QHash<QPair<QPair<int, int>, quint64>, QQueue<tapeRecord>> replayQueue;  //By call, VFO and argument
+};
+
+extern RigTape rigTape;
+
+const char *tape_call_name(int call);
+
+
+//* Hamlib calls made by RigDaemon, recorded or replayed by rigTape
+int tape_open(RIG *rig);
+int tape_get_freq(RIG *rig, vfo_t vfo, freq_t *freq);
+int tape_set_freq(RIG *rig, vfo_t vfo, freq_t freq);
+int tape_get_mode(RIG *rig, vfo_t vfo, rmode_t *mode, pbwidth_t *width);
+int tape_set_mode(RIG *rig, vfo_t vfo, rmode_t mode, pbwidth_t width);
+int tape_get_vfo(RIG *rig, vfo_t *vfo);
+int tape_get_split_vfo(RIG *rig, vfo_t vfo, split_t *split, vfo_t *txVfo);
+int tape_set_split_vfo(RIG *rig, vfo_t vfo, split_t split, vfo_t txVfo);
+int tape_set_split_freq(RIG *rig, vfo_t vfo, freq_t txFreq);
+int tape_get_ptt(RIG *rig, vfo_t vfo, ptt_t *ptt);
+int tape_set_ptt(RIG *rig, vfo_t vfo, ptt_t ptt);
+int tape_get_powerstat(RIG *rig, powerstat_t *status);
+int tape_set_powerstat(RIG *rig, powerstat_t status);
+int tape_get_level(RIG *rig, vfo_t vfo, setting_t level, value_t *val);
+int tape_set_level(RIG *rig, vfo_t vfo, setting_t level, value_t val);
+int tape_get_func(RIG *rig, vfo_t vfo, setting_t func, int *status);
+int tape_set_func(RIG *rig, vfo_t vfo, setting_t func, int status);
+int tape_get_ant(RIG *rig, vfo_t vfo, ant_t ant, value_t *option, ant_t *antCurr, ant_t *antTx, ant_t *antRx);
+int tape_set_ant(RIG *rig, vfo_t vfo, ant_t ant, value_t option);
+int tape_get_rit(RIG *rig, vfo_t vfo, shortfreq_t *rit);
+int tape_set_rit(RIG *rig, vfo_t vfo, shortfreq_t rit);
+int tape_get_xit(RIG *rig, vfo_t vfo, shortfreq_t *xit);
+int tape_set_xit(RIG *rig, vfo_t vfo, shortfreq_t xit);
+int tape_get_rptr_shift(RIG *rig, vfo_t vfo, rptr_shift_t *shift);
+int tape_set_rptr_shift(RIG *rig, vfo_t vfo, rptr_shift_t shift);
+int tape_get_rptr_offs(RIG *rig, vfo_t vfo, shortfreq_t *offs);
+int tape_set_rptr_offs(RIG *rig, vfo_t vfo, shortfreq_t offs);
+int tape_get_ctcss_tone(RIG *rig, vfo_t vfo, tone_t *tone);
+int tape_set_ctcss_tone(RIG *rig, vfo_t vfo, tone_t tone);
+int tape_get_dcs_code(RIG *rig, vfo_t vfo, tone_t *code);
+int tape_set_dcs_code(RIG *rig, vfo_t vfo, tone_t code);
+int tape_vfo_op(RIG *rig, vfo_t vfo, vfo_op_t op);
+int tape_send_morse(RIG *rig, vfo_t vfo, const char *msg);
+int tape_send_voice_mem(RIG *rig, vfo_t vfo, int ch);
+int tape_get_channel(RIG *rig, vfo_t vfo, channel_t *chan, int readOnly);
+int tape_set_channel(RIG *rig, vfo_t vfo, const channel_t *chan);
+
+#endif // RIGTAPE_H
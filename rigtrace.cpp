@@ -0,0 +1,134 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rigtrace.h"
+
+#include <QThread>
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+
+RigTrace rigTrace;
+
+
+RigTrace::RigTrace()
+{
+    tracing.storeRelaxed(0);
+    clock.start();
+}
+
+RigTrace::~RigTrace()
+{
+    qDeleteAll(buffers);
+}
+
+void RigTrace::start()
+{
+    QMutexLocker locker(&bufferMutex);
+    for (int i = 0; i < buffers.size(); i++) buffers.at(i)->head.storeRelaxed(0);
+    tracing.storeRelease(1);
+    qInfo() << "Trace started";
+}
+
+void RigTrace::stop()
+{
+    tracing.storeRelease(0);
+    qInfo() << "Trace stopped";
+}
+
+RigTrace::traceBuffer *RigTrace::buffer()
+{
+    static thread_local traceBuffer *threadBuffer = nullptr;
+    if (threadBuffer) return threadBuffer;
+
+    QMutexLocker locker(&bufferMutex);
+    threadBuffer = new traceBuffer;
+    threadBuffer->tid = buffers.size() + 1;
+    threadBuffer->thread = QThread::currentThread()->objectName();
+    if (threadBuffer->thread.isEmpty()) threadBuffer->thread = QString("Thread %1").arg(threadBuffer->tid);
+    threadBuffer->head.storeRelaxed(0);
+    buffers.append(threadBuffer);
+    return threadBuffer;
+}
+
+//* Single writer per buffer, the head is published after the event is written
+void RigTrace::append(const traceEvent &event)
+{
+    traceBuffer *buf = buffer();
+    quint64 head = buf->head.loadRelaxed();
+    buf->event[head % TRACE_BUFFER] = event;
+    buf->head.storeRelease(head + 1);
+}
+
+void RigTrace::add(const char *cat, const char *name, qint64 ts, qint64 dur)
+{
+    if (!enabled()) return;
+    append({name, cat, ts, dur, 'X'});
+}
+
+void RigTrace::counter(const char *name, qint64 value)
+{
+    if (!enabled()) return;
+    append({name, "counter", now(), value, 'C'});
+}
+
+//* Save after stop(), events still being written by a running thread may be lost
+bool RigTrace::save(QString fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qWarning() << "Unable to write trace" << fileName;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    QMutexLocker locker(&bufferMutex);
+    quint64 count = 0;
+    bool first = true;
+
+    for (int n = 0; n < buffers.size(); n++)
+    {
+        const traceBuffer *buf = buffers.at(n);
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buf->tid
+            << ",\"args\":{\"name\":\"" << buf->thread << "\"}}";
+        first = false;
+
+        quint64 head = buf->head.loadAcquire();
+        quint64 tail = head > TRACE_BUFFER ? head - TRACE_BUFFER : 0;
+
+        for (quint64 i = tail; i < head; i++)
+        {
+            const traceEvent &event = buf->event[i % TRACE_BUFFER];
+            out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.cat << "\",\"ph\":\"" << event.ph
+                << "\",\"pid\":1,\"tid\":" << buf->tid << ",\"ts\":" << QString::number(event.ts / 1000.0, 'f', 3);
+            if (event.ph == 'X') out << ",\"dur\":" << QString::number(event.dur / 1000.0, 'f', 3) << "}";
+            else out << ",\"args\":{\"value\":" << event.dur << "}}";
+        }
+        count += head - tail;
+    }
+
+    out << "\n]}\n";
+    file.close();
+
+    qInfo() << "Trace saved" << fileName << count << "events";
+    return true;
+}
@@ -0,0 +1,92 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef RIGTRACE_H
+#define RIGTRACE_H
+
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+
+#define TRACE_BUFFER 32768  //Events per thread, the oldest are overwritten
+
+
+struct traceEvent
+{
+    const char *name;   //Static strings only
+    const char *cat;
+    qint64 ts;  //ns
+    qint64 dur; //ns, or the value of a counter
+    char ph;    //Chrome trace event phase, 'X' complete or 'C' counter
+};
+
+
+//* Opt-in timeline of poll cycles, Hamlib calls and repaints, saved as Chrome trace event JSON (Perfetto, chrome://tracing)
+class RigTrace
+{
+public:
+    RigTrace();
+    ~RigTrace();
+
+    bool enabled() const { return tracing.loadRelaxed(); }
+    qint64 now() const { return clock.nsecsElapsed(); }
+
+    void start();
+    void stop();
+    void add(const char *cat, const char *name, qint64 ts, qint64 dur);
+    void counter(const char *name, qint64 value);
+    bool save(QString fileName);
+
+private:
+    struct traceBuffer
+    {
+        int tid;
+        QString thread;
+        QAtomicInteger<quint64> head;
+        traceEvent event[TRACE_BUFFER];
+    };
+
+    traceBuffer *buffer();  //Buffer of the calling thread, created on first use
+    void append(const traceEvent &event);
+
+    QAtomicInteger<int> tracing;
+    QElapsedTimer clock;
+    QMutex bufferMutex; //Only taken when a thread writes its first event
+    QList<traceBuffer *> buffers;
+};
+
+extern RigTrace rigTrace;
+
+
+//* Complete event covering the lifetime of the scope, near zero cost while tracing is off
+class TraceScope
+{
+public:
+    TraceScope(const char *cat, const char *name) : traceCat(cat), traceName(name), start(rigTrace.enabled() ? rigTrace.now() : -1) {}
+    ~TraceScope() { if (start >= 0) rigTrace.add(traceCat, traceName, start, rigTrace.now() - start); }
+
+private:
+    const char *traceCat;
+    const char *traceName;
+    qint64 start;
+};
+
+#endif // RIGTRACE_H
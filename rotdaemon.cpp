@@ -0,0 +1,143 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "rotdaemon.h"
+
+#include <QDebug>
+
+#include <cmath>
+
+
+RotDaemon::RotDaemon(QObject *parent) : QObject(parent)
+{
+    lastAz = lastEl = 0;
+    targetPending = false;
+    targetAz = targetEl = 0;
+    pollFast = 250;
+    pollSlow = 2000;
+}
+
+RotDaemon::~RotDaemon()
+{
+    rotDisconnect();
+}
+
+//* Open the rotator, runs on the rotator thread
+void RotDaemon::rotConnect(unsigned rotModel, QString rotPort, unsigned serialSpeed, int pollFast, int pollSlow)
+{
+    rotDisconnect();
+
+    this->pollFast = pollFast;
+    this->pollSlow = pollSlow;
+
+    my_rot = rot_init(rotModel);
+    if (!my_rot)    //Wrong rotator number
+    {
+        emit connected(-RIG_EINVAL, "");
+        return;
+    }
+
+    strncpy(my_rot->state.rotport.pathname, rotPort.toLatin1(), HAMLIB_FILPATHLEN - 1);
+    if (serialSpeed) my_rot->state.rotport.parm.serial.rate = serialSpeed;
+
+    int retcode = rot_open(my_rot);
+    if (retcode != RIG_OK)
+    {
+        rot_cleanup(my_rot);
+        my_rot = nullptr;
+        emit connected(retcode, "");
+        return;
+    }
+
+    qInfo() << "Rotator connected" << my_rot->caps->model_name;
+    emit connected(RIG_OK, my_rot->caps->model_name);
+
+    if (!pollTimer)
+    {
+        pollTimer = new QTimer(this);
+        pollTimer->setSingleShot(true);
+        connect(pollTimer, &QTimer::timeout, this, &RotDaemon::rotUpdate);
+    }
+    rotUpdate();
+}
+
+void RotDaemon::rotDisconnect()
+{
+    if (pollTimer) pollTimer->stop();
+
+    if (my_rot)
+    {
+        rot_close(my_rot);
+        rot_cleanup(my_rot);
+        my_rot = nullptr;
+        qInfo() << "Rotator disconnected";
+    }
+}
+
+void RotDaemon::setPosition(double azimuth, double elevation)
+{
+    if (!my_rot) return;
+
+    int retcode = rot_set_position(my_rot, azimuth, elevation);
+    if (retcode == RIG_OK)
+    {
+        targetPending = true;
+        targetAz = azimuth;
+        targetEl = elevation;
+    }
+    else qWarning() << "Rotator set position" << rigerror(retcode);
+
+    pollTimer->start(0);    //Poll now and speed up
+}
+
+void RotDaemon::stop()
+{
+    if (!my_rot) return;
+
+    rot_stop(my_rot);
+    targetPending = false;
+
+    pollTimer->start(0);
+}
+
+//* Poll the position, fast while moving and slow when parked
+void RotDaemon::rotUpdate()
+{
+    if (!my_rot) return;
+
+    azimuth_t az;
+    elevation_t el;
+    bool moving = false;
+
+    if (rot_get_position(my_rot, &az, &el) == RIG_OK)
+    {
+        rot_status_t status;
+        if (rot_get_status(my_rot, &status) == RIG_OK) moving = status & ROT_STATUS_MOVING;
+
+        if (fabs(az - lastAz) > 0.5 || fabs(el - lastEl) > 0.5) moving = true;    //Backend without status
+        if (targetPending && fabs(az - targetAz) <= 1.0 && fabs(el - targetEl) <= 1.0) targetPending = false;  //Target reached
+
+        lastAz = az;
+        lastEl = el;
+
+        emit positionUpdated(az, el, moving || targetPending);
+    }
+
+    pollTimer->start((moving || targetPending) ? pollFast : pollSlow);
+}
@@ -0,0 +1,57 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef ROTDAEMON_H
+#define ROTDAEMON_H
+
+#include <QObject>
+#include <QTimer>
+#include <rotator.h>
+
+
+class RotDaemon : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RotDaemon(QObject *parent = nullptr);
+    ~RotDaemon();
+
+public slots:
+    void rotConnect(unsigned rotModel, QString rotPort, unsigned serialSpeed, int pollFast, int pollSlow);
+    void rotDisconnect();
+    void setPosition(double azimuth, double elevation);
+    void stop();
+
+signals:
+    void connected(int retcode, QString name);
+    void positionUpdated(double azimuth, double elevation, bool moving);
+
+private:
+    void rotUpdate();
+
+    ROT *my_rot = nullptr;
+    QTimer *pollTimer = nullptr;    //Created in the rotator thread
+    int pollFast, pollSlow;
+    double lastAz, lastEl;
+    bool targetPending; //Go-to sent and position not reached yet
+    double targetAz, targetEl;
+};
+
+#endif // ROTDAEMON_H
@@ -18,8 +18,10 @@
 
 
 #include "smeter.h"
+#include "rigtrace.h"
 #include <QPainter>
 #include <math.h>
+#include <QtMath>
 
 SMeter::SMeter(QWidget *parent) : QWidget(parent)
 {
@@ -38,30 +40,64 @@ SMeter::SMeter(QWidget *parent) : QWidget(parent)
 
     meterTx = false;
 
+    value = minValue;
     currentValue = minValue;
     peakValue = minValue;
-    peakFactor = 0.1;
+    attackTime = 20;
+    decayTime = 150;
+    peakDecayTime = 1000;
+
+    animTimer.setTimerType(Qt::PreciseTimer);
+    animTimer.setInterval(METER_FRAME_MS);
+    connect(&animTimer, &QTimer::timeout, this, &SMeter::animate);
 
     peakHold = true;
 }
 
 void SMeter::paintEvent(QPaintEvent *)
 {
+    TraceScope trace("paint", "SMeter");
+    if (background.isNull() || background.devicePixelRatio() != devicePixelRatioF()) drawBackground();
+
     QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
+
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    drawProgress(&painter);
+    if (peakHold) drawPeak(&painter);
+}
+
+//* Render the static parts, frame and scales, into the background pixmap
+void SMeter::drawBackground()
+{
+    qreal dpr = devicePixelRatioF();
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
+
+    QPainter painter(&background);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
 
-    QFont font;
-    font = painter.font();
+    QFont font = this->font();  //Widget font, the pixmap painter has the default one
     font.setPointSize(font.pointSize() - 2);
     painter.setFont(font);
 
     drawMeter(&painter);
-    drawProgress(&painter);
-    if (peakHold) drawPeak(&painter);
     drawScaleSMeter(&painter);
     drawScalePWRMeter(&painter);
 }
 
+void SMeter::resizeEvent(QResizeEvent *)
+{
+    background = QPixmap();
+}
+
+void SMeter::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::PaletteChange || event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange) background = QPixmap();
+    QWidget::changeEvent(event);
+}
+
 void SMeter::drawMeter(QPainter *painter)
 {
     painter->save();
@@ -148,8 +184,6 @@ void SMeter::drawPeak(QPainter *painter)
     double increment = length / (max - min);
     double initX;
 
-    if (currentValue>=peakValue) peakValue = currentValue;
-    else peakValue = peakValue - peakFactor*(peakValue - currentValue);
     if (peakValue>max) peakValue = max;
 
     if (peakValue>gate) painter->setBrush(QColor(Qt::red));
@@ -318,11 +352,14 @@ void SMeter::drawScaleSMeter(QPainter *painter)
 void SMeter::setMinValue(double value)
 {
     minValue = value;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setMaxValue(double value)
 {
     maxValue = value;
+    background = QPixmap();
     update();
 }
 
@@ -334,26 +371,36 @@ void SMeter::setGateValue(double value)
 void SMeter::setLongStep(double value)
 {
     longStep = value;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setShortStep(double value)
 {
     shortStep = value;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setPrecision(int value)
 {
     precision = value;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setBgColor(QColor color)
 {
     bgColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setLineColor(QColor color)
 {
     lineColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setProgressColor(QColor color)
@@ -364,12 +411,20 @@ void SMeter::setProgressColor(QColor color)
 void SMeter::setScaleColor(QColor color)
 {
     scaleColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SMeter::setValue(double value)
 {
-    currentValue = value;
-    update(1, height()/3+2+1, width()-14, height()/3-4-2);
+    if (!meterTx && value > 60) value = 60;  //Trim to the scale, the animation settles on it
+    else if (meterTx && value > maxValue) value = maxValue;
+    this->value = value;
+    if (!animTimer.isActive())
+    {
+        animClock.start();
+        animTimer.start();
+    }
 }
 
 void SMeter::setValue(int value)
@@ -392,13 +447,37 @@ void SMeter::setPeak(bool Peak)
     peakHold = Peak;
 }
 
-void SMeter::setPeakFactor(double factor)
+void SMeter::setBallistics(int attack, int decay, int peakDecay)
 {
-    peakFactor = factor;
+    attackTime = attack;
+    decayTime = decay;
+    peakDecayTime = peakDecay;
 }
 
 void SMeter::resetPeakValue()
 {
     if (meterTx) peakValue = minValue;
     else peakValue = -54;
+    currentValue = value;   //No animation across a scale change
+}
+
+//* Meter ballistics, exponential approach to the target with time constants in ms, independent of the poll rate
+void SMeter::animate()
+{
+    double dt = animClock.restart();
+    if (dt <= 0) return;
+
+    double tau = (value > currentValue) ? attackTime : decayTime;
+    currentValue = value + (currentValue - value) * qExp(-dt / qMax(tau, 1.0));
+
+    if (currentValue >= peakValue) peakValue = currentValue;
+    else peakValue = currentValue + (peakValue - currentValue) * qExp(-dt / qMax((double)peakDecayTime, 1.0));
+
+    double span = meterTx ? maxValue - minValue : 60 + 54;
+    double settle = span / 1000;    //Below a pixel on any meter width
+    if (qAbs(currentValue - value) < settle) currentValue = value;
+    if (!peakHold || peakValue - currentValue < settle) peakValue = currentValue;
+
+    update(1, height()/3+2+1, width()-14, height()/3-4-2);
+    if (currentValue == value && peakValue == currentValue) animTimer.stop();   //Steady
 }
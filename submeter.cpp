@@ -18,8 +18,10 @@
 
 
 #include "submeter.h"
+#include "rigtrace.h"
 #include <QPainter>
 #include <math.h>
+#include <QtMath>
 
 SubMeter::SubMeter(QWidget *parent) : QWidget(parent)
 {
@@ -38,29 +40,63 @@ SubMeter::SubMeter(QWidget *parent) : QWidget(parent)
 
     meterSWR = 0;
 
+    value = 0;
     currentValue = 0;
     peakValue = minValue;
-    peakFactor = 0.1;
+    attackTime = 20;
+    decayTime = 150;
+    peakDecayTime = 1000;
+
+    animTimer.setTimerType(Qt::PreciseTimer);
+    animTimer.setInterval(METER_FRAME_MS);
+    connect(&animTimer, &QTimer::timeout, this, &SubMeter::animate);
 
     peakHold = true;
 }
 
 void SubMeter::paintEvent(QPaintEvent *)
 {
+    TraceScope trace("paint", "SubMeter");
+    if (background.isNull() || background.devicePixelRatio() != devicePixelRatioF()) drawBackground();
+
     QPainter painter(this);
+    painter.drawPixmap(0, 0, background);
+
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    drawProgress(&painter);
+    if (peakHold) drawPeak(&painter);
+}
+
+//* Render the static parts, frame and scales, into the background pixmap
+void SubMeter::drawBackground()
+{
+    qreal dpr = devicePixelRatioF();
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
+
+    QPainter painter(&background);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
 
-    QFont font;
-    font = painter.font();
+    QFont font = this->font();  //Widget font, the pixmap painter has the default one
     font.setPointSize(font.pointSize() - 2);
     painter.setFont(font);
 
     drawMeter(&painter);
-    drawProgress(&painter);
-    if (peakHold) drawPeak(&painter);
     drawScale(&painter);
 }
 
+void SubMeter::resizeEvent(QResizeEvent *)
+{
+    background = QPixmap();
+}
+
+void SubMeter::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::PaletteChange || event->type() == QEvent::FontChange || event->type() == QEvent::StyleChange) background = QPixmap();
+    QWidget::changeEvent(event);
+}
+
 void SubMeter::drawMeter(QPainter *painter)
 {
     painter->save();
@@ -137,8 +173,6 @@ void SubMeter::drawPeak(QPainter *painter)
     double increment;
     double initX;
 
-    if (currentValue>=peakValue) peakValue = currentValue;
-    else peakValue = peakValue - peakFactor*(peakValue - currentValue);
     if (peakValue>max) peakValue = max;
 
     if (peakValue>gate) painter->setBrush(QColor(Qt::red));
@@ -255,12 +289,14 @@ void SubMeter::drawScale(QPainter *painter)
 void SubMeter::setMinValue(double value)
 {
     minValue = value;
+    background = QPixmap();
     update();
 }
 
 void SubMeter::setMaxValue(double value)
 {
     maxValue = value;
+    background = QPixmap();
     update();
 }
 
@@ -272,29 +308,36 @@ void SubMeter::setGateValue(double value)
 void SubMeter::setLongStep(double value)
 {
     longStep = value;
+    background = QPixmap();
     update();
 }
 
 void SubMeter::setShortStep(double value)
 {
     shortStep = value;
+    background = QPixmap();
     update();
 }
 
 void SubMeter::setPrecision(int value)
 {
     precision = value;
+    background = QPixmap();
     update();
 }
 
 void SubMeter::setBgColor(QColor color)
 {
     bgColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SubMeter::setLineColor(QColor color)
 {
     lineColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SubMeter::setProgressColor(QColor color)
@@ -305,12 +348,19 @@ void SubMeter::setProgressColor(QColor color)
 void SubMeter::setScaleColor(QColor color)
 {
     scaleColor = color;
+    background = QPixmap();
+    update();
 }
 
 void SubMeter::setValue(double value)
 {
-    currentValue = value;
-    update();
+    if (value > maxValue) value = maxValue;  //Trim to the scale, the animation settles on it
+    this->value = value;
+    if (!animTimer.isActive())
+    {
+        animClock.start();
+        animTimer.start();
+    }
 }
 
 void SubMeter::setValue(int value)
@@ -321,6 +371,8 @@ void SubMeter::setValue(int value)
 void SubMeter::setMeterSWR(bool swr)
 {
     meterSWR = swr;
+    background = QPixmap();
+    update();
 }
 
 void SubMeter::setPeak(bool Peak)
@@ -328,13 +380,37 @@ void SubMeter::setPeak(bool Peak)
     peakHold = Peak;
 }
 
-void SubMeter::setPeakFactor(double factor)
+void SubMeter::setBallistics(int attack, int decay, int peakDecay)
 {
-    peakFactor = factor;
+    attackTime = attack;
+    decayTime = decay;
+    peakDecayTime = peakDecay;
 }
 
 void SubMeter::resetPeakValue()
 {
     if (!meterSWR) peakValue = minValue;
     else peakValue = 1.0;
+    currentValue = value;   //No animation across a scale change
+}
+
+//* Meter ballistics, exponential approach to the target with time constants in ms, independent of the poll rate
+void SubMeter::animate()
+{
+    double dt = animClock.restart();
+    if (dt <= 0) return;
+
+    double tau = (value > currentValue) ? attackTime : decayTime;
+    currentValue = value + (currentValue - value) * qExp(-dt / qMax(tau, 1.0));
+
+    if (currentValue >= peakValue) peakValue = currentValue;
+    else peakValue = currentValue + (peakValue - currentValue) * qExp(-dt / qMax((double)peakDecayTime, 1.0));
+
+    double span = maxValue - minValue;
+    double settle = span / 1000;    //Below a pixel on any meter width
+    if (qAbs(currentValue - value) < settle) currentValue = value;
+    if (!peakHold || peakValue - currentValue < settle) peakValue = currentValue;
+
+    update(1, height()/3+2+1, width()-14, height()/3-4-2);
+    if (currentValue == value && peakValue == currentValue) animTimer.stop();   //Steady
 }
@@ -21,6 +21,11 @@
 #define SUBMETER_H
 
 #include <QWidget>
+#include <QPixmap>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#define METER_FRAME_MS 16   //Animation clock, about 60 Hz
 
 class SubMeter : public QWidget
 {
@@ -47,11 +52,17 @@ public slots:
     void setMeterSWR(bool swr);
 
     void setPeak(bool Peak);
-    void setPeakFactor(double factor);
+    void setBallistics(int attack, int decay, int peakDecay);
     void resetPeakValue();
 
 protected:
     void paintEvent(QPaintEvent *);
+    void resizeEvent(QResizeEvent *);
+    void changeEvent(QEvent *event);
+    void drawBackground();
+
+private slots:
+    void animate();
     void drawMeter(QPainter *painter);
     void drawProgress(QPainter *painter);
     void drawPeak(QPainter *painter);
@@ -70,7 +81,13 @@ private:
     double value;   //target value
     double currentValue;    //current value
     double peakValue;   //peak value
-    double peakFactor;  //peak factor
+
+    int attackTime; //Time constant (ms) toward a higher value
+    int decayTime;  //Time constant (ms) toward a lower value
+    int peakDecayTime;  //Peak time constant (ms)
+
+    QTimer animTimer;   //Runs only while the bar or the peak is moving
+    QElapsedTimer animClock;
 
     bool peakHold;  //Peak hold
 
@@ -79,6 +96,8 @@ private:
     QColor progressColor;   //progress color
     QColor scaleColor;   //scale text color
 
+    QPixmap background; //Cached frame and scales, redrawn on resize, color, font or scale change
+
 signals:
 
 };
@@ -0,0 +1,160 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "survey.h"
+
+#include <QDebug>
+
+#include <cstring>
+
+static_assert(sizeof(QAtomicInteger<quint64>) == sizeof(quint64), "Survey count is accessed in place");
+
+
+SurveyFile::SurveyFile()
+{
+    rowSize = 0;
+}
+
+SurveyFile::~SurveyFile()
+{
+    close();
+}
+
+//* Open the survey file and map it in memory
+//* The file size is fixed by the layout, so memory use is constant however long the survey runs
+bool SurveyFile::open(QString fileName, double start, double step, int bins, int rows)
+{
+    close();
+
+    if (bins <= 0 || rows <= 0) return false;
+
+    rowSize = sizeof(qint64) + bins;
+    qint64 fileSize = sizeof(surveyHeader) + rowSize * rows;
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite)) return false;
+
+    bool reuse = false;
+    if (file.size() == fileSize)
+    {
+        surveyHeader old;
+        if (file.read(reinterpret_cast<char *>(&old), sizeof(old)) == sizeof(old))
+        {
+            reuse = old.magic == SURVEY_MAGIC && old.version == SURVEY_VERSION && old.start == start && old.step == step && old.bins == (quint32)bins && old.rows == (quint32)rows;
+        }
+    }
+
+    if (!reuse && !file.resize(fileSize))
+    {
+        file.close();
+        return false;
+    }
+
+    map = file.map(0, fileSize);
+    if (!map)
+    {
+        file.close();
+        return false;
+    }
+    header = reinterpret_cast<surveyHeader *>(map);
+
+    if (!reuse) //New survey
+    {
+        memset(map, 0, fileSize);
+        header->magic = SURVEY_MAGIC;
+        header->version = SURVEY_VERSION;
+        header->start = start;
+        header->step = step;
+        header->bins = bins;
+        header->rows = rows;
+        header->count = 0;
+    }
+
+    qInfo() << "Survey file" << fileName << (reuse ? "resumed" : "created") << header->count << "rows";
+
+    return true;
+}
+
+void SurveyFile::close()
+{
+    if (map)
+    {
+        file.unmap(map);
+        map = nullptr;
+        header = nullptr;
+    }
+    if (file.isOpen()) file.close();
+}
+
+bool SurveyFile::isOpen()
+{
+    return map != nullptr;
+}
+
+//* Append a row, the count is published with a release store after the row data so that readers never see a partial row
+void SurveyFile::append(qint64 time, const qint8 *levels)
+{
+    if (!map) return;
+
+    quint64 count = rowCount().loadRelaxed();   //Single writer
+    uchar *p = map + sizeof(surveyHeader) + rowSize * (count % header->rows);
+    memcpy(p, &time, sizeof(qint64));
+    memcpy(p + sizeof(qint64), levels, header->bins);
+
+    rowCount().storeRelease(count + 1);
+}
+
+//* The oldest slot of a full ring is excluded, it is the next one the writer overwrites
+const qint8 *SurveyFile::row(quint64 n, qint64 *time)
+{
+    if (!map) return nullptr;
+
+    quint64 count = rowCount().loadAcquire();
+    if (n >= count || count - n >= header->rows) return nullptr;
+
+    const uchar *p = map + sizeof(surveyHeader) + rowSize * (n % header->rows);
+    if (time) memcpy(time, p, sizeof(qint64));
+
+    return reinterpret_cast<const qint8 *>(p + sizeof(qint64));
+}
+
+quint64 SurveyFile::count()
+{
+    return map ? rowCount().loadAcquire() : 0;
+}
+
+int SurveyFile::bins()
+{
+    return map ? header->bins : 0;
+}
+
+int SurveyFile::rows()
+{
+    return map ? header->rows : 0;
+}
+
+double SurveyFile::start()
+{
+    return map ? header->start : 0;
+}
+
+double SurveyFile::step()
+{
+    return map ? header->step : 0;
+}
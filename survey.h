@@ -0,0 +1,74 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef SURVEY_H
+#define SURVEY_H
+
+#include <QFile>
+#include <QString>
+#include <QAtomicInteger>
+
+#define SURVEY_MAGIC 0x56525553 //"SURV"
+#define SURVEY_VERSION 1
+#define SURVEY_NO_LEVEL -128    //Bin not read, rig error
+#define SURVEY_RETRIES 3    //Reads of a bin before it is skipped
+#define SURVEY_ERRORS 20    //Consecutive skipped bins that end the survey
+
+
+//* Survey file layout: header followed by a ring of fixed-size rows
+//* Each row is the sweep UTC time (ms) and one STRENGTH level per bin (dB relative to S9)
+typedef struct {
+    quint32 magic;
+    quint32 version;
+    double start, step; //Frequency of the first bin and bin width (Hz)
+    quint32 bins;   //Bins per row
+    quint32 rows;   //Ring capacity
+    quint64 count;  //Rows written since creation, the newest row is (count - 1) % rows
+} surveyHeader;
+
+
+class SurveyFile
+{
+public:
+    SurveyFile();
+    ~SurveyFile();
+
+    bool open(QString fileName, double start, double step, int bins, int rows);    //Create, or reuse if the layout matches
+    void close();
+    bool isOpen();
+
+    void append(qint64 time, const qint8 *levels); //Writer side, one row
+    const qint8 *row(quint64 n, qint64 *time);  //Row n (0 = first written), nullptr if overwritten or next to be
+
+    quint64 count();
+    int bins();
+    int rows();
+    double start();
+    double step();
+
+private:
+    QFile file;
+    uchar *map = nullptr;
+    surveyHeader *header = nullptr;
+    qint64 rowSize;
+
+    QAtomicInteger<quint64> &rowCount() { return *reinterpret_cast<QAtomicInteger<quint64> *>(&header->count); }    //Published by the writer, read from the GUI
+};
+
+#endif // SURVEY_H
@@ -0,0 +1,322 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+//* CatRadio binary debug log decoder, prints the same text format as catradio.log
+//*
+//* logdecode [-c category]... [-f "yyyy-mm-dd hh:mm:ss"] [-t "yyyy-mm-dd hh:mm:ss"] [-s] catradio.blog
+//*   -c  only the given categories (repeatable)
+//*   -f  from local time, -t to local time
+//*   -s  summary, record count per category
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+
+#define LOG_MAGIC "CRBLOG1\n"
+#define LOG_TAG_STRING 1
+#define LOG_TAG_MESSAGE 2
+#define LOG_TAG_FORMAT 3
+#define LOG_TAG_DROPPED 4
+
+
+struct logArg {
+    char tag;
+    int64_t i;
+    double f;
+    uint64_t s;
+};
+
+class Reader {
+public:
+    explicit Reader(FILE *f) : file(f) {}
+
+    bool byte(int *value)
+    {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        *value = c;
+        return true;
+    }
+
+    bool varint(uint64_t *value)
+    {
+        *value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            int c;
+            if (!byte(&c)) return false;
+            *value |= uint64_t(c & 0x7f) << shift;
+            if (!(c & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool fixed64(uint64_t *value)
+    {
+        unsigned char b[8];
+        if (fread(b, 1, 8, file) != 8) return false;
+        *value = 0;
+        for (int n = 0; n < 8; n++) *value |= uint64_t(b[n]) << (8 * n);
+        return true;
+    }
+
+    bool bytes(std::string *value, uint64_t length)
+    {
+        if (length > (1u << 24)) return false;
+        value->resize(length);
+        return length == 0 || fread(&(*value)[0], 1, length, file) == length;
+    }
+
+private:
+    FILE *file;
+};
+
+
+static std::map<uint64_t, std::string> strings;
+
+static const char *str(uint64_t id, const char *fallback)
+{
+    auto i = strings.find(id);
+    return (id && i != strings.end()) ? i->second.c_str() : fallback;
+}
+
+//* Same expansion as debugLogger
+static std::string formatArgs(const std::string &format, const std::vector<logArg> &args)
+{
+    std::string text;
+    size_t n = 0;
+    char buf[64];
+
+    for (size_t p = 0; p < format.size(); p++)
+    {
+        if (format[p] != '%' || p + 1 >= format.size())
+        {
+            text += format[p];
+            continue;
+        }
+
+        char conv = format[++p];
+        if (conv == '%' || n >= args.size())
+        {
+            text += '%';
+            if (conv != '%') text += conv;
+            continue;
+        }
+
+        const logArg &arg = args[n++];
+        if (arg.tag == 's') text += str(arg.s, "(null)");
+        else if (arg.tag == 'f')
+        {
+            snprintf(buf, sizeof(buf), conv == 'g' ? "%g" : "%.3f", arg.f);
+            text += buf;
+        }
+        else if (conv == 'x')
+        {
+            snprintf(buf, sizeof(buf), "%llx", (unsigned long long)arg.i);
+            text += buf;
+        }
+        else
+        {
+            snprintf(buf, sizeof(buf), "%lld", (long long)arg.i);
+            text += buf;
+        }
+    }
+
+    return text;
+}
+
+static std::string timestamp(int64_t ms)
+{
+    time_t seconds = time_t(ms / 1000);
+    struct tm local;
+    localtime_r(&seconds, &local);
+
+    char date[32], zone[8], buf[64];
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &local);
+    strftime(zone, sizeof(zone), "%z", &local);
+    snprintf(buf, sizeof(buf), "%s.%03d%s", date, int(ms % 1000), zone);
+    return buf;
+}
+
+static int64_t parseTime(const char *text)
+{
+    struct tm local = {};
+    if (sscanf(text, "%d-%d-%d %d:%d:%d", &local.tm_year, &local.tm_mon, &local.tm_mday, &local.tm_hour, &local.tm_min, &local.tm_sec) < 3)
+    {
+        fprintf(stderr, "Invalid time %s\n", text);
+        exit(1);
+    }
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    local.tm_isdst = -1;
+    return int64_t(mktime(&local)) * 1000;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: logdecode [-c category]... [-f \"yyyy-mm-dd hh:mm:ss\"] [-t \"yyyy-mm-dd hh:mm:ss\"] [-s] file.blog\n");
+    exit(1);
+}
+
+
+int main(int argc, char *argv[])
+{
+    std::set<std::string> categories;
+    int64_t from = INT64_MIN, to = INT64_MAX;
+    bool summary = false;
+    const char *fileName = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-c") && i + 1 < argc) categories.insert(argv[++i]);
+        else if (!strcmp(argv[i], "-f") && i + 1 < argc) from = parseTime(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) to = parseTime(argv[++i]);
+        else if (!strcmp(argv[i], "-s")) summary = true;
+        else if (argv[i][0] == '-' || fileName) usage();
+        else fileName = argv[i];
+    }
+    if (!fileName) usage();
+
+    FILE *file = fopen(fileName, "rb");
+    if (!file)
+    {
+        perror(fileName);
+        return 1;
+    }
+
+    Reader in(file);
+    std::string magic;
+    uint64_t wallStart, monoStart;
+    if (!in.bytes(&magic, strlen(LOG_MAGIC)) || magic != LOG_MAGIC || !in.fixed64(&wallStart) || !in.fixed64(&monoStart))
+    {
+        fprintf(stderr, "%s: not a CatRadio binary log\n", fileName);
+        return 1;
+    }
+
+    static const char *typeName[5] = {"Debug", "Warning", "Critical", "Fatal", "Info"};
+    std::map<std::string, uint64_t> count;
+    int64_t time = int64_t(monoStart);  //ns
+    uint64_t dropped = 0;
+    int tag;
+
+    while (in.byte(&tag))
+    {
+        bool ok = true;
+
+        if (tag == LOG_TAG_STRING)
+        {
+            uint64_t id, length;
+            std::string value;
+            ok = in.varint(&id) && in.varint(&length) && in.bytes(&value, length);
+            strings[id] = value;
+        }
+        else if (tag == LOG_TAG_DROPPED)
+        {
+            uint64_t lost;
+            ok = in.varint(&lost);
+            dropped += lost;
+            if (ok && !summary) printf("%s: [Warning] %llu log messages dropped, queue full\n", timestamp(int64_t(wallStart) + (time - int64_t(monoStart)) / 1000000).c_str(), (unsigned long long)lost);
+        }
+        else if (tag == LOG_TAG_MESSAGE || tag == LOG_TAG_FORMAT)
+        {
+            int type;
+            uint64_t dt, category;
+            ok = in.byte(&type) && in.varint(&dt) && in.varint(&category);
+            time += int64_t(dt);
+
+            std::string msg, context;
+            if (ok && tag == LOG_TAG_MESSAGE)
+            {
+                uint64_t fileId, function, line, length;
+                ok = in.varint(&fileId) && in.varint(&function) && in.varint(&line) && in.varint(&length) && in.bytes(&msg, length);
+                context = std::string(str(fileId, "unknown")) + ":" + std::to_string(line) + " " + str(function, "unknown");
+            }
+            else if (ok)
+            {
+                uint64_t format, count;
+                ok = in.varint(&format) && in.varint(&count) && count <= 16;
+                std::vector<logArg> args;
+                for (uint64_t n = 0; ok && n < count; n++)
+                {
+                    logArg arg = {};
+                    int argTag;
+                    ok = in.byte(&argTag);
+                    arg.tag = char(argTag);
+                    if (!ok) break;
+                    if (arg.tag == 's') ok = in.varint(&arg.s);
+                    else if (arg.tag == 'f')
+                    {
+                        uint64_t bits;
+                        ok = in.fixed64(&bits);
+                        memcpy(&arg.f, &bits, 8);
+                    }
+                    else
+                    {
+                        uint64_t zigzag;
+                        ok = in.varint(&zigzag);
+                        arg.i = int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+                    }
+                    args.push_back(arg);
+                }
+                msg = formatArgs(str(format, ""), args);
+                context = "unknown:0 unknown";
+            }
+            if (!ok)
+            {
+                fprintf(stderr, "Truncated record\n");
+                break;
+            }
+
+            std::string cat = str(category, "default");
+            int64_t wall = int64_t(wallStart) + (time - int64_t(monoStart)) / 1000000;
+            if (wall < from || wall > to) continue;
+            if (!categories.empty() && !categories.count(cat)) continue;
+
+            if (summary) count[cat]++;
+            else printf("%s: [%s] %s  (%s [%s])\n", timestamp(wall).c_str(), typeName[type <= 4 ? type : 0], msg.c_str(), context.c_str(), cat.c_str());
+        }
+        else
+        {
+            fprintf(stderr, "Unknown record %d, file corrupted\n", tag);
+            return 1;
+        }
+
+        if (!ok)
+        {
+            fprintf(stderr, "Truncated record\n");
+            break;
+        }
+    }
+
+    if (summary)
+    {
+        for (const auto &c : count) printf("%-16s %llu\n", c.first.c_str(), (unsigned long long)c.second);
+        if (dropped) printf("%-16s %llu\n", "(dropped)", (unsigned long long)dropped);
+    }
+
+    fclose(file);
+    return 0;
+}
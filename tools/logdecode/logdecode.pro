@@ -0,0 +1,11 @@
+# CatRadio binary debug log decoder
+# qmake tools/logdecode/logdecode.pro && make, or g++ -O2 -o logdecode logdecode.cpp
+
+TEMPLATE = app
+CONFIG += c++11 console
+CONFIG -= qt app_bundle
+
+TARGET = logdecode
+
+SOURCES += \
+    logdecode.cpp
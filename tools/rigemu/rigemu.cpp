@@ -0,0 +1,277 @@
+/**
+ ** This file is part of the CatRadio project.
+ ** Copyright 2026 Gianfranco Sordetti IZ8EWD <iz8ewd@pianetaradio.it>.
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+//* CAT protocol emulator on a pseudo-terminal, Linux
+//* Kenwood TS-2000 (Hamlib model 2014) or Yaesu FT-991 (Hamlib model 1035) subset,
+//* with baud rate accurate delays and error injection.
+//*
+//* rigemu [-p kenwood|yaesu] [-b baud] [-l latency_ms] [-e error_rate] [-s seed] [-v]
+//* Prints the slave device, e.g. /dev/pts/5, to be used as rigPort in CatRadio.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <csignal>
+#include <string>
+#include <map>
+#include <random>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+
+
+//* Parameter command, query argument length and default value
+struct catParam {
+    const char *cmd;
+    int qlen;   //Query argument length, e.g. SM0; = 1
+    const char *value;
+};
+
+static const catParam kenwoodParam[] = {
+    {"FA", 0, "00014074000"}, {"FB", 0, "00007074000"}, {"MD", 0, "2"}, {"FR", 0, "0"}, {"FT", 0, "0"},
+    {"PC", 0, "100"}, {"AG", 1, "128"}, {"RG", 0, "255"}, {"SQ", 1, "000"}, {"GT", 0, "002"},
+    {"NB", 0, "0"}, {"NR", 0, "0"}, {"RA", 0, "0000"}, {"PA", 0, "00"}, {"AN", 0, "1"},
+    {"KS", 0, "020"}, {"RT", 0, "0"}, {"XT", 0, "0"}, {"AI", 0, "0"}, {"PS", 0, "1"},
+    {"BC", 0, "0"}, {"NT", 0, "0"}, {"PR", 0, "0"}, {"ML", 0, "000"}, {"MG", 0, "050"},
+    {"SH", 0, "00"}, {"SL", 0, "00"}, {"FW", 0, "0000"}, {"LK", 0, "00"}, {"AC", 0, "000"},
+    {"VX", 0, "0"}, {"BY", 0, "00"}, {"CN", 0, "00"}, {"TO", 0, "0"}, {"CT", 0, "0"}, {nullptr, 0, nullptr}
+};
+
+static const catParam yaesuParam[] = {
+    {"FA", 0, "014074000"}, {"FB", 0, "007074000"}, {"MD", 1, "2"}, {"FT", 0, "0"}, {"VS", 0, "0"},
+    {"PC", 0, "050"}, {"AG", 1, "128"}, {"RG", 1, "255"}, {"SQ", 1, "000"}, {"GT", 1, "3"},
+    {"NB", 1, "0"}, {"NR", 1, "0"}, {"RL", 1, "08"}, {"RA", 1, "0"}, {"PA", 1, "0"}, {"AN", 1, "1"},
+    {"KS", 0, "020"}, {"RT", 0, "0"}, {"XT", 0, "0"}, {"AI", 0, "0"}, {"PS", 0, "1"}, {"ST", 0, "0"},
+    {"BC", 1, "0"}, {"BP", 2, "000"}, {"PR", 1, "0"}, {"ML", 1, "000"}, {"MG", 0, "050"}, {"SH", 1, "00"},
+    {"NA", 1, "0"}, {"CO", 2, "0000"}, {"IS", 1, "+0000"}, {"LK", 0, "0"}, {"VX", 0, "0"}, {"BI", 0, "0"},
+    {"CT", 1, "0"}, {"CN", 2, "000"}, {"OS", 1, "0"}, {"EX", 3, ""}, {"SC", 0, "0"}, {"TX", 0, "0"}, {nullptr, 0, nullptr}
+};
+
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int)
+{
+    running = 0;
+}
+
+
+class RigEmu
+{
+public:
+    RigEmu(bool yaesu, unsigned seed) : yaesu(yaesu), rng(seed)
+    {
+        for (const catParam *p = yaesu ? yaesuParam : kenwoodParam; p->cmd; p++) table[p->cmd] = p;
+    }
+
+    //* Execute one command (without ';'), return the reply or an empty string
+    std::string command(const std::string &cmd)
+    {
+        if (cmd.size() < 2) return "?;";
+        std::string name = cmd.substr(0, 2);
+        std::string arg = cmd.substr(2);
+
+        if (name == "ID") return yaesu ? "ID0570;" : "ID019;";
+        if (name == "IF" && arg.empty()) return info();
+        if (name == "SM") return smeter(arg);
+        if (!yaesu && (name == "TX" || name == "RX"))   //Kenwood PTT, no reply
+        {
+            ptt = (name == "TX");
+            return "";
+        }
+        if (yaesu && name == "TX" && !arg.empty()) ptt = (arg != "0");
+
+        auto it = table.find(name);
+        if (it == table.end()) return "?;";
+
+        int qlen = it->second->qlen;
+        if ((int)arg.size() < qlen) return "?;";
+        std::string key = name + arg.substr(0, qlen);
+
+        if ((int)arg.size() == qlen)  //Query
+        {
+            auto v = value.find(key);
+            return key + (v != value.end() ? v->second : it->second->value) + ";";
+        }
+
+        value[key] = arg.substr(qlen);  //Set, no reply
+        return "";
+    }
+
+private:
+    bool yaesu;
+    std::mt19937 rng;
+    std::map<std::string, const catParam *> table;
+    std::map<std::string, std::string> value;
+    bool ptt = false;
+    double fade = 0;
+
+    std::string get(const std::string &key, const char *def)
+    {
+        auto v = value.find(key);
+        if (v != value.end()) return v->second;
+        auto p = table.find(key.substr(0, 2));
+        return p != table.end() ? p->second->value : def;
+    }
+
+    std::string pad(std::string s, size_t n, char c = '0')
+    {
+        if (s.size() > n) return s.substr(s.size() - n);
+        return std::string(n - s.size(), c) + s;
+    }
+
+    //* Slowly fading signal with noise, S9 about half scale
+    std::string smeter(const std::string &arg)
+    {
+        fade += 0.05;
+        double level = 0.45 + 0.3 * sin(fade) + std::uniform_real_distribution<double>(-0.05, 0.05)(rng);
+        level = ptt ? 0 : std::min(1.0, std::max(0.0, level));
+        std::string sub = arg.empty() ? "0" : arg.substr(0, 1);
+
+        if (yaesu) return "SM" + sub + pad(std::to_string(int(level * 255)), 3) + ";";
+        return "SM" + sub + pad(std::to_string(int(level * 30)), 4) + ";";
+    }
+
+    std::string info()
+    {
+        if (yaesu)  //IF P1 mem(3) P2 freq(9) P3 clar(5) P4 P5 P6 mode P7 vfo P8 ctcss P9(2) P10 shift
+        {
+            std::string mode = get("MD0", "2");
+            return "IF001" + pad(get("FA", "014074000"), 9) + "+0000" + "00" + mode.substr(mode.size() - 1) + "0000" + "0;";
+        }
+
+        //IF P1 freq(11) P2 step(5) P3 rit(5) P4 P5 P6 P7 mem(2) P8 tx P9 mode P10 vfo P11 scan P12 split P13 tone P14(2) P15 shift
+        std::string vfo = get("FR", "0");
+        std::string freq = get(vfo == "1" ? "FB" : "FA", "00014074000");
+        std::string split = (get("FT", "0") != vfo) ? "1" : "0";
+        return "IF" + pad(freq, 11) + "     " + "+0000" + get("RT", "0") + get("XT", "0") + "000" + (ptt ? "1" : "0") + get("MD", "2") + vfo + "0" + split + "0" + "00" + "0;";
+    }
+};
+
+
+static void usage()
+{
+    fprintf(stderr, "rigemu [-p kenwood|yaesu] [-b baud] [-l latency_ms] [-e error_rate] [-s seed] [-v]\n"
+                    "  -p  protocol, kenwood = TS-2000 (Hamlib 2014), yaesu = FT-991 (Hamlib 1035)\n"
+                    "  -b  baud rate for the transfer delay, 0 = no delay (default 9600)\n"
+                    "  -l  processing latency per command (ms)\n"
+                    "  -e  error rate 0..1, drops, '?;' or garbled replies\n");
+}
+
+
+int main(int argc, char *argv[])
+{
+    bool yaesu = false;
+    int baud = 9600;
+    int latency = 0;
+    double errorRate = 0;
+    unsigned seed = 1;
+    bool verbose = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "p:b:l:e:s:vh")) != -1)
+    {
+        switch (opt)
+        {
+        case 'p': yaesu = !strcmp(optarg, "yaesu"); break;
+        case 'b': baud = atoi(optarg); break;
+        case 'l': latency = atoi(optarg); break;
+        case 'e': errorRate = atof(optarg); break;
+        case 's': seed = strtoul(optarg, nullptr, 10); break;
+        case 'v': verbose = true; break;
+        default: usage(); return 1;
+        }
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) || unlockpt(master))
+    {
+        perror("rigemu: pty");
+        return 1;
+    }
+    const char *slaveName = ptsname(master);
+
+    int slave = open(slaveName, O_RDWR | O_NOCTTY);   //Held open, the master does not hang up when the client closes
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    printf("%s\n", slaveName);
+    fflush(stdout);
+    fprintf(stderr, "rigemu: %s on %s, %d baud, latency %d ms, error rate %.3f\n", yaesu ? "FT-991" : "TS-2000", slaveName, baud, latency, errorRate);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    RigEmu rig(yaesu, seed);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> chance(0, 1);
+    std::string buffer;
+    long commands = 0, errors = 0;
+
+    while (running)
+    {
+        struct pollfd pfd = {master, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;
+
+        char data[256];
+        ssize_t n = read(master, data, sizeof(data));
+        if (n <= 0) continue;
+        buffer.append(data, n);
+
+        size_t end;
+        while ((end = buffer.find(';')) != std::string::npos)
+        {
+            std::string cmd = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            while (!cmd.empty() && (cmd[0] == '\r' || cmd[0] == '\n' || cmd[0] == ' ')) cmd.erase(0, 1);
+            if (cmd.empty()) continue;
+
+            std::string reply = rig.command(cmd);
+            commands++;
+
+            if (errorRate > 0 && chance(rng) < errorRate)   //Error injection
+            {
+                errors++;
+                int kind = rng() % 3;
+                if (kind == 0) reply.clear();   //Dropped, the client times out
+                else if (kind == 1) reply = "?;";
+                else if (!reply.empty()) reply[rng() % reply.size()] ^= 0x20; //Garbled byte
+            }
+
+            //Wire time, 10 bits per byte both ways, plus processing
+            long delay = latency * 1000L;
+            if (baud > 0) delay += (cmd.size() + 1 + reply.size()) * 10000000L / baud;
+            if (delay > 0) usleep(delay);
+
+            if (!reply.empty() && write(master, reply.data(), reply.size()) < 0) perror("rigemu: write");
+            if (verbose) fprintf(stderr, "%s; -> %s\n", cmd.c_str(), reply.c_str());
+        }
+        if (buffer.size() > 1024) buffer.clear();   //Garbage without terminator
+    }
+
+    fprintf(stderr, "rigemu: %ld commands, %ld errors injected\n", commands, errors);
+    close(slave);
+    close(master);
+    return 0;
+}
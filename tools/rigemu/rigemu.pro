@@ -0,0 +1,11 @@
+# CAT protocol emulator on a pseudo-terminal, Linux only
+# qmake tools/rigemu/rigemu.pro && make, or g++ -O2 -o rigemu rigemu.cpp
+
+TEMPLATE = app
+CONFIG += c++11 console
+CONFIG -= qt app_bundle
+
+TARGET = rigemu
+
+SOURCES += \
+    rigemu.cpp
@@ -18,6 +18,7 @@
 
 
 #include "vfodisplay.h"
+#include "rigtrace.h"
 
 #include <QPainter>
 #include <QInputEvent>
@@ -33,46 +34,73 @@ vfoDisplay::vfoDisplay(QWidget *parent) : QWidget(parent)
     textColor = QColor(Qt::black);
 
     vfoDisplayMode = 0;
+
+    currentValue = 0;
+    textWidth = 0;
+    textHeight = 0;
 }
 
-void vfoDisplay::paintEvent(QPaintEvent *)
+void vfoDisplay::paintEvent(QPaintEvent *event)
 {
-    //setMouseTracking(true);
+    TraceScope trace("paint", "vfoDisplay");
 
-    QPainter painter(this);
-    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    //setMouseTracking(true);
 
-    QFont font;
-    font = painter.font();
-    font.setPointSize(height() - 18);
-    painter.setFont(font);
+    if (background.isNull() || background.devicePixelRatio() != devicePixelRatioF()) drawAtlas();
 
+    QPainter painter(this);
     drawDisplay(&painter);
-    drawText(&painter);
+    drawText(&painter, event->region());
 }
 
-void vfoDisplay::drawDisplay(QPainter *painter)
+//* Render the frame with the dot and the digit glyphs, redrawn on resize, color, font or DPR change
+void vfoDisplay::drawAtlas()
 {
-    painter->save();
+    qreal dpr = devicePixelRatioF();
+
+    QFont font = this->font();
+    font.setPointSize(qMax(height() - 18, 1));
+
+    QFontMetrics meterFont(font);
+    textHeight = meterFont.ascent();
+    textWidth = meterFont.horizontalAdvance("0",-1);
+
+    background = QPixmap(size() * dpr);
+    background.setDevicePixelRatio(dpr);
+    background.fill(Qt::transparent);
+
+    QPainter painter(&background);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    painter.setFont(font);
 
     QPen pen(lineColor, 1, Qt::SolidLine, Qt::SquareCap, Qt::MiterJoin);
-    painter->setPen(pen);
-    painter->setBrush(bgColor);
-    painter->drawRect(1, 1, width()-3, height()-2);
-    painter->restore();
-}
+    painter.setPen(pen);
+    painter.setBrush(bgColor);
+    painter.drawRect(1, 1, width()-3, height()-2);
 
-void vfoDisplay::drawText(QPainter *painter)
-{
-    painter->save();
-    painter->setPen(textColor);
+    painter.setPen(textColor);
+    painter.drawText(QPointF(width()-3-(textWidth+2)*2-4, textHeight), ".");
+    painter.end();
 
-    QFontMetrics meterFont(painter->font());
-    double textHeight = meterFont.ascent();
-    textWidth = meterFont.horizontalAdvance("0",-1);
+    glyphs = QPixmap(QSize((textWidth+4)*10, height()) * dpr);   //2 px margin each side of a cell
+    glyphs.setDevicePixelRatio(dpr);
+    glyphs.fill(Qt::transparent);
 
-    QPointF textPot;
+    painter.begin(&glyphs);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    painter.setFont(font);
+    painter.setPen(textColor);
+    for (int d = 0; d < 10; d++) painter.drawText(QPointF((textWidth+4)*d+2, textHeight), QString::number(d));
+}
 
+void vfoDisplay::drawDisplay(QPainter *painter)
+{
+    painter->drawPixmap(0, 0, background);
+}
+
+void vfoDisplay::drawText(QPainter *painter, const QRegion &region)
+{
+    qreal dpr = glyphs.devicePixelRatio();
     long val = currentValue;
 
     for (int i = 1; i < 10; i++)
@@ -80,40 +108,79 @@ void vfoDisplay::drawText(QPainter *painter)
         val = qFloor(val/10);
         int d = val % 10;
 
-        if (i==2)
-        {
-            textPot = QPointF(width()-3-(textWidth+2)*i-4, textHeight);
-            painter->drawText(textPot, ".");
-        }
+        if (val==0 && d==0) break;  //Leading blanks
+        if (!region.intersects(digitRect(i))) continue;
 
-        textPot = QPointF(width()-3-(textWidth+2)*i, textHeight);
+        QRectF source((textWidth+4)*d*dpr, 0, (textWidth+4)*dpr, height()*dpr);
+        painter->drawPixmap(QPointF(width()-3-(textWidth+2)*i-2, 0), glyphs, source);
+    }
+}
 
-        if (val==0 && d==0) painter->drawText(textPot, " ");
-        else painter->drawText(textPot, QString::number(d));
+QRect vfoDisplay::digitRect(int i)
+{
+    return QRect(width()-3-(textWidth+2)*i-2, 0, textWidth+4, height());
+}
+
+void vfoDisplay::updateDigits(unsigned long oldValue)
+{
+    if (background.isNull())    //Not painted yet
+    {
+        update();
+        return;
+    }
+
+    QRegion dirty;
+    unsigned long oldVal = oldValue, newVal = currentValue;
+
+    for (int i = 1; i < 10; i++)
+    {
+        oldVal = oldVal/10;
+        newVal = newVal/10;
+        if (oldVal%10 != newVal%10 || (oldVal==0) != (newVal==0)) dirty += digitRect(i);    //Digit or blank changed
     }
 
-    painter->restore();
+    if (!dirty.isEmpty()) update(dirty);
+}
+
+void vfoDisplay::resizeEvent(QResizeEvent *)
+{
+    background = QPixmap();
+}
+
+void vfoDisplay::changeEvent(QEvent *event)
+{
+    if (event->type() == QEvent::FontChange) background = QPixmap();
+    QWidget::changeEvent(event);
 }
 
 void vfoDisplay::setBgColor(QColor color)
 {
     bgColor = color;
+    background = QPixmap();
+    update();
 }
 
 void vfoDisplay::setLineColor(QColor color)
 {
     lineColor = color;
+    background = QPixmap();
+    update();
 }
 
 void vfoDisplay::setTextColor(QColor color)
 {
     textColor = color;
+    background = QPixmap();
+    update();
 }
 
 void vfoDisplay::setValue(unsigned long value)
 {
+    if (value == currentValue) return;
+
+    unsigned long oldValue = currentValue;
     currentValue = value;
-    update();
+    updateDigits(oldValue);
 }
 
 void vfoDisplay::setMode(int mode)
@@ -127,6 +194,7 @@ void vfoDisplay::mousePressEvent(QMouseEvent *event)
     event->accept();
 
     QPoint pointerPos = event->pos();
+    unsigned long oldValue = currentValue;
 
     for (int i = 1; i < 10; i ++)
     {
@@ -147,7 +215,7 @@ void vfoDisplay::mousePressEvent(QMouseEvent *event)
         }
     }
 
-    update();
+    updateDigits(oldValue);
     emit on_valueChanged(currentValue);
 }
 
@@ -161,6 +229,7 @@ void vfoDisplay::wheelEvent(QWheelEvent *event)
 #else
     QPointF pointerPos = event->pos();
 #endif
+    unsigned long oldValue = currentValue;
 
     for (int i = 1; i < 10; i ++)
     {
@@ -171,6 +240,6 @@ void vfoDisplay::wheelEvent(QWheelEvent *event)
         }
     }
 
-    update();
+    updateDigits(oldValue);
     emit on_valueChanged(currentValue);
 }
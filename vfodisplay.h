@@ -2,6 +2,7 @@
 #define VFODISPLAY_H
 
 #include <QWidget>
+#include <QPixmap>
 
 class vfoDisplay : public QWidget
 {
@@ -22,9 +23,12 @@ signals:
     void on_valueChanged(int value);
 
 protected:
-    void paintEvent(QPaintEvent *);
+    void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *);
+    void changeEvent(QEvent *event);
     void drawDisplay(QPainter *painter);
-    void drawText(QPainter *painter);
+    void drawText(QPainter *painter, const QRegion &region);
+    void drawAtlas();
     void mousePressEvent(QMouseEvent *event);   //Mouse buttons
     void wheelEvent(QWheelEvent *event);   //Mouse wheel
 
@@ -39,6 +43,13 @@ private:
     int vfoDisplayMode; //0: use Left/Right mouse button, 1: click digit Up or Down
 
     int textWidth;  //number width
+
+    QPixmap background; //Frame and dot
+    QPixmap glyphs; //Digits 0-9 atlas, same size, colors and DPR of the widget
+    double textHeight;  //Digit baseline
+
+    QRect digitRect(int i); //Cell of digit i, 1 = tens of Hz
+    void updateDigits(unsigned long oldValue);  //Repaint the digits that differ from oldValue
 };
 
 #endif // VFODISPLAY_H